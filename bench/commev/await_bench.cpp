@@ -0,0 +1,131 @@
+// 协程等待事件的开销：N 个协程同时 co_await 同一个事件，发布一次后全部在 QueueExecutor 上恢复
+// 对比每个等待者占一个线程、用条件变量等待的写法；协程等待期间不占线程，只占一个等待记录
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "await.h"
+
+namespace {
+
+using namespace OHOS::common::event;
+using namespace std::chrono_literals;
+
+const char kEvent[] = "usual.event.bench.AWAIT";
+
+Detached WaitOnce(AwaitSubscriber &subscriber, QueueExecutor &executor, std::int64_t &resumed) {
+    auto record = co_await NextEvent(subscriber, kEvent, 10s, executor);
+    if (record) {
+        ++resumed;
+    }
+}
+
+// 参数为同时等待的协程数
+void BM_AwaitWakeAll(benchmark::State &state) {
+    AwaitSubscriber subscriber;
+    QueueExecutor executor;
+    const std::int64_t waiters = state.range(0);
+    std::int64_t resumed = 0;
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < waiters; ++i) {
+            WaitOnce(subscriber, executor, resumed);
+        }
+        Publish(kEvent);
+        const std::int64_t expected = resumed + waiters;
+        while (resumed < expected) {
+            executor.wait(1ms);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * waiters);
+}
+BENCHMARK(BM_AwaitWakeAll)->Arg(1)->Arg(1000)->Arg(10000)->UseRealTime();
+
+// 一个协程在循环里反复等待，结果先存到变量再判断，每收到一次事件记一次
+Detached WaitInLoop(AwaitSubscriber &subscriber, QueueExecutor &executor, std::int64_t &resumed, bool &stop) {
+    while (!stop) {
+        auto record = co_await NextEvent(subscriber, kEvent, 10s, executor);
+        if (!record) {
+            break;
+        }
+        ++resumed;
+    }
+}
+
+// 同一个协程反复等待、恢复；也是 await.h 所要求写法的回归用例。GCC 12.2 上 co_await 写在 if/while 的条件里，
+// 如 if (co_await ...) 或 if ((co_await ...).has_value())，恢复时会崩溃
+void BM_AwaitInLoop(benchmark::State &state) {
+    QueueExecutor executor;
+    std::int64_t resumed = 0;
+    bool stop = false;
+    {
+        AwaitSubscriber subscriber;
+        WaitInLoop(subscriber, executor, resumed, stop);
+        for (auto _ : state) {
+            const std::int64_t expected = resumed + 1;
+            Publish(kEvent);
+            while (resumed < expected) {
+                executor.wait(1ms);
+            }
+        }
+        stop = true;
+    }
+    // 订阅者析构时以空结果恢复最后一次等待，协程跳出循环结束
+    executor.poll();
+    if (resumed != state.iterations()) {
+        state.SkipWithError("resumed count mismatch");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AwaitInLoop)->UseRealTime();
+
+// 每个等待者一个线程，收到事件时用条件变量唤醒全部线程
+void BM_ThreadWakeAll(benchmark::State &state) {
+    const char *events[] = {kEvent};
+    SubscribeInfo info(events, 1);
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::uint64_t generation = 0;
+    Subscriber subscriber(&info, [&](const RcvData &) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++generation;
+        }
+        cv.notify_all();
+    });
+    subscriber.subscribe();
+    const std::int64_t waiters = state.range(0);
+    for (auto _ : state) {
+        std::atomic<std::int64_t> ready{0};
+        std::vector<std::thread> threads;
+        std::uint64_t start;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            start = generation;
+        }
+        for (std::int64_t i = 0; i < waiters; ++i) {
+            threads.emplace_back([&] {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.fetch_add(1);
+                cv.wait(lock, [&] { return generation != start; });
+            });
+        }
+        while (ready.load() < waiters) {
+            std::this_thread::yield();
+        }
+        Publish(kEvent);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * waiters);
+}
+BENCHMARK(BM_ThreadWakeAll)->Arg(1)->Arg(1000)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
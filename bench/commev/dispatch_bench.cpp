@@ -0,0 +1,175 @@
+// 收到事件后按事件名找处理函数的开销：strcmp 链、unordered_map 和 EventDispatcher 的完美哈希表
+// 订阅的事件数为 8/32/64，查询时依次轮转全部订阅的事件
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "event.h"
+
+namespace {
+
+using namespace OHOS::common::event;
+
+const char *const kEvents[] = {
+    COMMON_EVENT_SHUTDOWN,
+    COMMON_EVENT_BATTERY_CHANGED,
+    COMMON_EVENT_BATTERY_LOW,
+    COMMON_EVENT_BATTERY_OKAY,
+    COMMON_EVENT_POWER_CONNECTED,
+    COMMON_EVENT_POWER_DISCONNECTED,
+    COMMON_EVENT_SCREEN_OFF,
+    COMMON_EVENT_SCREEN_ON,
+    COMMON_EVENT_THERMAL_LEVEL_CHANGED,
+    COMMON_EVENT_TIME_TICK,
+    COMMON_EVENT_TIME_CHANGED,
+    COMMON_EVENT_TIMEZONE_CHANGED,
+    COMMON_EVENT_PACKAGE_ADDED,
+    COMMON_EVENT_PACKAGE_REMOVED,
+    COMMON_EVENT_PACKAGE_CHANGED,
+    COMMON_EVENT_PACKAGE_RESTARTED,
+    COMMON_EVENT_PACKAGE_DATA_CLEARED,
+    COMMON_EVENT_PACKAGE_CACHE_CLEARED,
+    COMMON_EVENT_CONFIGURATION_CHANGED,
+    COMMON_EVENT_MANAGE_PACKAGE_STORAGE,
+    COMMON_EVENT_DRIVE_MODE,
+    COMMON_EVENT_HOME_MODE,
+    COMMON_EVENT_OFFICE_MODE,
+    COMMON_EVENT_USER_STARTED,
+    COMMON_EVENT_USER_BACKGROUND,
+    COMMON_EVENT_USER_FOREGROUND,
+    COMMON_EVENT_USER_SWITCHED,
+    COMMON_EVENT_USER_STARTING,
+    COMMON_EVENT_USER_UNLOCKED,
+    COMMON_EVENT_USER_STOPPING,
+    COMMON_EVENT_USER_STOPPED,
+    COMMON_EVENT_WIFI_POWER_STATE,
+    COMMON_EVENT_WIFI_SCAN_FINISHED,
+    COMMON_EVENT_WIFI_RSSI_VALUE,
+    COMMON_EVENT_WIFI_CONN_STATE,
+    COMMON_EVENT_WIFI_HOTSPOT_STATE,
+    COMMON_EVENT_WIFI_AP_STA_JOIN,
+    COMMON_EVENT_WIFI_AP_STA_LEAVE,
+    COMMON_EVENT_WIFI_MPLINK_STATE_CHANGE,
+    COMMON_EVENT_WIFI_P2P_CONN_STATE,
+    COMMON_EVENT_WIFI_P2P_STATE_CHANGED,
+    COMMON_EVENT_WIFI_P2P_PEERS_STATE_CHANGED,
+    COMMON_EVENT_WIFI_P2P_PEERS_DISCOVERY_STATE_CHANGED,
+    COMMON_EVENT_WIFI_P2P_CURRENT_DEVICE_STATE_CHANGED,
+    COMMON_EVENT_WIFI_P2P_GROUP_STATE_CHANGED,
+    COMMON_EVENT_USB_STATE,
+    COMMON_EVENT_USB_PORT_CHANGED,
+    COMMON_EVENT_USB_DEVICE_ATTACHED,
+    COMMON_EVENT_USB_DEVICE_DETACHED,
+    COMMON_EVENT_DISK_REMOVED,
+    COMMON_EVENT_DISK_UNMOUNTED,
+    COMMON_EVENT_DISK_MOUNTED,
+    COMMON_EVENT_DISK_BAD_REMOVAL,
+    COMMON_EVENT_DISK_UNMOUNTABLE,
+    COMMON_EVENT_DISK_EJECT,
+    COMMON_EVENT_VOLUME_REMOVED,
+    COMMON_EVENT_VOLUME_UNMOUNTED,
+    COMMON_EVENT_VOLUME_MOUNTED,
+    COMMON_EVENT_VOLUME_BAD_REMOVAL,
+    COMMON_EVENT_VOLUME_EJECT,
+    COMMON_EVENT_AIRPLANE_MODE_CHANGED,
+    COMMON_EVENT_SCREEN_LOCKED,
+    COMMON_EVENT_SCREEN_UNLOCKED,
+    COMMON_EVENT_CHARGING,
+};
+constexpr std::size_t kEventCount = sizeof(kEvents) / sizeof(kEvents[0]);
+
+// 模拟 RcvData::event() 返回的字符串：内容相同但地址不同，避免按指针比较取巧
+std::vector<std::string> Incoming(std::size_t count) {
+    return std::vector<std::string>(kEvents, kEvents + count);
+}
+
+void BM_StrcmpChain(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto incoming = Incoming(count);
+    std::size_t next = 0;
+    for (auto _ : state) {
+        const char *event = incoming[next].c_str();
+        std::size_t slot = count;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (std::strcmp(event, kEvents[i]) == 0) {
+                slot = i;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(slot);
+        next = next + 1 == count ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StrcmpChain)->Arg(8)->Arg(32)->Arg(kEventCount);
+
+void BM_UnorderedMap(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto incoming = Incoming(count);
+    std::unordered_map<std::string_view, std::size_t> table;
+    for (std::size_t i = 0; i < count; ++i) {
+        table.emplace(kEvents[i], i);
+    }
+    std::size_t next = 0;
+    for (auto _ : state) {
+        auto it = table.find(incoming[next].c_str());
+        benchmark::DoNotOptimize(it);
+        next = next + 1 == count ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnorderedMap)->Arg(8)->Arg(32)->Arg(kEventCount);
+
+void BM_EventDispatcher(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto incoming = Incoming(count);
+    std::vector<std::pair<const char *, EventDispatcher::Handler>> handlers;
+    for (std::size_t i = 0; i < count; ++i) {
+        handlers.emplace_back(kEvents[i], nullptr);
+    }
+    const EventDispatcher dispatcher(handlers.begin(), handlers.end());
+    std::size_t next = 0;
+    for (auto _ : state) {
+        std::size_t slot = dispatcher.slotOf(incoming[next].c_str());
+        benchmark::DoNotOptimize(slot);
+        next = next + 1 == count ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventDispatcher)->Arg(8)->Arg(32)->Arg(kEventCount);
+
+// 未订阅的事件
+void BM_EventDispatcherMiss(benchmark::State &state) {
+    std::vector<std::pair<const char *, EventDispatcher::Handler>> handlers;
+    for (std::size_t i = 0; i < kEventCount; ++i) {
+        handlers.emplace_back(kEvents[i], nullptr);
+    }
+    const EventDispatcher dispatcher(handlers.begin(), handlers.end());
+    const std::string event = "usual.event.hardware.usb.action.USB_ACCESSORY_ATTACHED";
+    for (auto _ : state) {
+        std::size_t slot = dispatcher.slotOf(event.c_str());
+        benchmark::DoNotOptimize(slot);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventDispatcherMiss);
+
+// 构造分发表的一次性开销
+void BM_EventDispatcherBuild(benchmark::State &state) {
+    std::vector<std::pair<const char *, EventDispatcher::Handler>> handlers;
+    for (std::size_t i = 0; i < kEventCount; ++i) {
+        handlers.emplace_back(kEvents[i], nullptr);
+    }
+    for (auto _ : state) {
+        EventDispatcher dispatcher(handlers.begin(), handlers.end());
+        benchmark::DoNotOptimize(dispatcher);
+    }
+}
+BENCHMARK(BM_EventDispatcherBuild);
+
+} // namespace
+
+BENCHMARK_MAIN();
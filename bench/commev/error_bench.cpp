@@ -0,0 +1,57 @@
+// 抛异常的接口和返回 Expected 的 try* 接口的开销对比
+// 失败路径用空事件名发布，桩实现和 CES 一样返回 COMMONEVENT_ERR_INVALID_PARAMETER
+#include <benchmark/benchmark.h>
+
+#include <system_error>
+
+#include "event.h"
+
+namespace {
+
+using namespace OHOS::common::event;
+
+const char kEvent[] = "usual.event.bench.ERROR_PATH";
+
+void BM_PublishThrowOk(benchmark::State &state) {
+    for (auto _ : state) {
+        try {
+            Publish(kEvent);
+        } catch (const std::system_error &e) {
+            benchmark::DoNotOptimize(e.code());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PublishThrowOk);
+
+void BM_PublishExpectedOk(benchmark::State &state) {
+    for (auto _ : state) {
+        auto result = TryPublish(kEvent);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PublishExpectedOk);
+
+void BM_PublishThrowFail(benchmark::State &state) {
+    for (auto _ : state) {
+        try {
+            Publish(nullptr);
+        } catch (const std::system_error &e) {
+            benchmark::DoNotOptimize(e.code());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PublishThrowFail);
+
+void BM_PublishExpectedFail(benchmark::State &state) {
+    for (auto _ : state) {
+        auto result = TryPublish(nullptr);
+        benchmark::DoNotOptimize(result.error());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PublishExpectedFail);
+
+} // namespace
@@ -0,0 +1,102 @@
+// 经过 bench/stub 中的进程内回环总线，测量从 Publish 到订阅者回调的端到端延迟和吞吐
+// 订阅和发布都走 commev 的封装类；注入的延迟模拟 CES 的两次 IPC，0 时只剩封装和投递线程本身的开销
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <commonevent_stub.h>
+
+#include "event.h"
+
+namespace {
+
+using namespace OHOS::common::event;
+
+const char kEvent[] = "usual.event.bench.LOOPBACK";
+
+// 等订阅者收到 expected 个事件
+void WaitFor(const std::atomic<std::int64_t> &received, std::int64_t expected) {
+    while (received.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+// 每次发布一个事件并等订阅者收到，参数为注入的延迟（微秒）
+void BM_LoopbackLatency(benchmark::State &state) {
+    CommonEventStub_SetLatency(static_cast<std::uint32_t>(state.range(0)));
+    const char *events[] = {kEvent};
+    SubscribeInfo info(events, 1);
+    std::atomic<std::int64_t> received{0};
+    Subscriber subscriber(&info, [&received](const RcvData &) { received.fetch_add(1, std::memory_order_release); });
+    subscriber.subscribe();
+    PublishInfo publishInfo(false);
+    publishInfo.setCode(1);
+    std::int64_t sent = 0;
+    for (auto _ : state) {
+        Publish(kEvent, publishInfo);
+        WaitFor(received, ++sent);
+    }
+    state.SetItemsProcessed(state.iterations());
+    subscriber.unSubscribe();
+    CommonEventStub_SetLatency(0);
+}
+BENCHMARK(BM_LoopbackLatency)->Arg(0)->Arg(50)->Arg(200)->UseRealTime();
+
+// 连续发布一批再等全部收到，参数为订阅者数
+void BM_LoopbackThroughput(benchmark::State &state) {
+    constexpr std::int64_t kBurst = 256;
+    const char *events[] = {kEvent};
+    SubscribeInfo info(events, 1);
+    std::atomic<std::int64_t> received{0};
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        subscribers.emplace_back(new Subscriber(
+            &info, [&received](const RcvData &) { received.fetch_add(1, std::memory_order_release); }));
+        subscribers.back()->subscribe();
+    }
+    PublishInfo publishInfo(false);
+    Parameters params;
+    params.setInt("sequence", 0);
+    params.setLong("timestamp", 0);
+    publishInfo.setParameters(params);
+    std::int64_t expected = 0;
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < kBurst; ++i) {
+            Publish(kEvent, publishInfo);
+        }
+        expected += kBurst * state.range(0);
+        WaitFor(received, expected);
+    }
+    state.SetItemsProcessed(state.iterations() * kBurst);
+}
+BENCHMARK(BM_LoopbackThroughput)->Arg(1)->Arg(4)->UseRealTime();
+
+// 有序事件依次经过全部订阅者，每个订阅者改写 code 后结束，参数为订阅者数
+void BM_LoopbackOrdered(benchmark::State &state) {
+    const char *events[] = {kEvent};
+    SubscribeInfo info(events, 1);
+    std::atomic<std::int64_t> received{0};
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        subscribers.emplace_back(new Subscriber(&info, [&received](const RcvData &data, CommonEvent_Subscriber *self) {
+            SetCodeToSubscriber(self, data.code() + 1);
+            FinishCommonEvent(self);
+            received.fetch_add(1, std::memory_order_release);
+        }));
+        subscribers.back()->subscribe();
+    }
+    PublishInfo publishInfo(true);
+    std::int64_t expected = 0;
+    for (auto _ : state) {
+        Publish(kEvent, publishInfo);
+        expected += state.range(0);
+        WaitFor(received, expected);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoopbackOrdered)->Arg(1)->Arg(4)->UseRealTime();
+
+} // namespace
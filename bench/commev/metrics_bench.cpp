@@ -0,0 +1,78 @@
+// 内置统计在热路径上的开销：直方图记录一次、经订阅者的缓存找到统计项后记录一次处理函数耗时（即每次回调多出的开销）、
+// 不经缓存直接查表，以及取一次快照的耗时；参数为事件名个数
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "event.h"
+
+namespace {
+
+using namespace OHOS::common::event;
+
+std::vector<std::string> EventNames(std::int64_t count) {
+    std::vector<std::string> names;
+    for (std::int64_t i = 0; i < count; ++i) {
+        names.push_back("usual.event.bench.METRICS_" + std::to_string(i));
+    }
+    return names;
+}
+
+void BM_HistogramRecord(benchmark::State &state) {
+    LatencyHistogram histogram;
+    std::uint64_t ns = 1;
+    for (auto _ : state) {
+        histogram.record(ns);
+        ns = ns * 7 % 1000003;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HistogramRecord)->ThreadRange(1, 4);
+
+#if COMMEV_METRICS
+
+// 同 HandlerTimer 的析构：取时钟、查缓存、两次原子加和一次直方图记录；
+// 事件数超过 EventStatsCache::kEntries 时缓存轮流失效，每次都要查表
+void BM_RecordHandler(benchmark::State &state) {
+    const auto names = EventNames(state.range(0));
+    detail::EventStatsCache cache;
+    std::size_t next = 0;
+    for (auto _ : state) {
+        const auto start = detail::MetricsClock::now();
+        auto &stats = cache.find(names[next].c_str());
+        stats.received.fetch_add(1, std::memory_order_relaxed);
+        stats.handler.record(detail::ElapsedNs(start));
+        next = (next + 1) % names.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordHandler)->Arg(1)->Arg(4)->Arg(16);
+
+// 不经缓存按事件名查表：计算哈希、探测、比较事件名
+void BM_RegistryFind(benchmark::State &state) {
+    const auto names = EventNames(state.range(0));
+    auto &registry = detail::EventMetricsRegistry::Instance();
+    std::size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&registry.find(names[next].c_str()));
+        next = (next + 1) % names.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RegistryFind)->Arg(1)->Arg(16)->Arg(64);
+
+void BM_SnapshotEventMetrics(benchmark::State &state) {
+    const auto names = EventNames(state.range(0));
+    for (const auto &name : names) {
+        detail::EventMetricsRegistry::Instance().find(name.c_str()).handler.record(1000);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SnapshotEventMetrics());
+    }
+}
+BENCHMARK(BM_SnapshotEventMetrics)->Arg(16)->Arg(64);
+
+#endif
+
+} // namespace
@@ -0,0 +1,17 @@
+// 关闭异常的构建也要能使用这些封装：各头文件在 -fno-exceptions 下都要能编译，这里只编译不运行
+#include "async.h"
+#include "bus.h"
+#include "coalesce.h"
+#include "error.h"
+#include "event.h"
+#include "expected.h"
+#include "metrics.h"
+#include "ordered.h"
+#include "pool.h"
+#include "record.h"
+#include "replay.h"
+#include "schema.h"
+
+#if defined(__cpp_impl_coroutine)
+# include "await.h"
+#endif
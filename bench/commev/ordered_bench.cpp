@@ -0,0 +1,110 @@
+// 有序事件经过一串订阅者的耗时：回调里直接结束，和取令牌后交给另一个线程结束
+// 令牌让回调线程立刻返回，代价是一次线程切换和计时登记；参数为订阅者数
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ordered.h"
+
+namespace {
+
+using namespace OHOS::common::event;
+
+const char kEvent[] = "usual.event.bench.ORDERED";
+
+void WaitFor(const std::atomic<std::int64_t> &received, std::int64_t expected) {
+    while (received.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+void BM_OrderedInline(benchmark::State &state) {
+    const char *events[] = {kEvent};
+    SubscribeInfo info(events, 1);
+    std::atomic<std::int64_t> received{0};
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        subscribers.emplace_back(new Subscriber(&info, [&received](const RcvData &, CommonEvent_Subscriber *self) {
+            FinishCommonEvent(self);
+            received.fetch_add(1, std::memory_order_release);
+        }));
+        subscribers.back()->subscribe();
+    }
+    PublishInfo publishInfo(true);
+    std::int64_t expected = 0;
+    for (auto _ : state) {
+        Publish(kEvent, publishInfo);
+        expected += state.range(0);
+        WaitFor(received, expected);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderedInline)->Arg(1)->Arg(4)->UseRealTime();
+
+// 取到的令牌交给一个工作线程结束
+void BM_OrderedToken(benchmark::State &state) {
+    OrderedEventTracker tracker;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<OrderedToken> tokens;
+    bool stopping = false;
+    std::atomic<std::int64_t> received{0};
+    std::thread worker([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            ready.wait(lock, [&] { return stopping || !tokens.empty(); });
+            if (tokens.empty()) {
+                return;
+            }
+            OrderedToken token = std::move(tokens.front());
+            tokens.pop_front();
+            lock.unlock();
+            token.setCode(1);
+            token.finish();
+            received.fetch_add(1, std::memory_order_release);
+            lock.lock();
+        }
+    });
+
+    const char *events[] = {kEvent};
+    SubscribeInfo info(events, 1);
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        subscribers.emplace_back(new Subscriber(&info, [&](const RcvData &, CommonEvent_Subscriber *self) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tokens.push_back(tracker.take(self));
+            }
+            ready.notify_one();
+        }));
+        subscribers.back()->subscribe();
+    }
+    PublishInfo publishInfo(true);
+    std::int64_t expected = 0;
+    for (auto _ : state) {
+        Publish(kEvent, publishInfo);
+        expected += state.range(0);
+        WaitFor(received, expected);
+    }
+    state.SetItemsProcessed(state.iterations());
+    const auto metrics = tracker.metrics();
+    state.counters["hold_ns"] =
+        metrics.taken ? static_cast<double>(metrics.totalHold.count()) / static_cast<double>(metrics.taken) : 0;
+
+    subscribers.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    worker.join();
+}
+BENCHMARK(BM_OrderedToken)->Arg(1)->Arg(4)->UseRealTime();
+
+} // namespace
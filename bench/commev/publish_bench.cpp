@@ -0,0 +1,108 @@
+// 高频发布时每次新建 PublishInfo/Parameters 和从 PublishPool 复用的开销对比
+// 每次发布带 code、data 和若干参数，其中只有一个参数每次都变，其余保持不变
+// libohcommonevent 由 bench/stub 中的桩实现代替，发布时会像 CES 一样把内容整体拷贝一份
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "pool.h"
+
+namespace {
+
+using namespace OHOS::common::event;
+
+const char kEvent[] = "usual.event.bench.SENSOR_SAMPLE";
+const char kData[] = "sensor=accel";
+
+std::vector<std::string> Keys(std::size_t count) {
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < count; ++i) {
+        keys.push_back("field" + std::to_string(i));
+    }
+    return keys;
+}
+
+void BM_PublishConstruct(benchmark::State &state) {
+    const auto keys = Keys(static_cast<std::size_t>(state.range(0)));
+    int sequence = 0;
+    for (auto _ : state) {
+        PublishInfo info(false);
+        Parameters params;
+        info.setCode(1);
+        info.setData(kData, sizeof(kData) - 1);
+        params.setInt(keys[0].c_str(), ++sequence);
+        for (std::size_t i = 1; i < keys.size(); ++i) {
+            params.setLong(keys[i].c_str(), static_cast<long>(i));
+        }
+        info.setParameters(params);
+        Publish(kEvent, info);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PublishConstruct)->Arg(2)->Arg(8)->Arg(32);
+
+// 每次发布都借出和归还一次
+void BM_PublishPooled(benchmark::State &state) {
+    const auto keys = Keys(static_cast<std::size_t>(state.range(0)));
+    PublishPool pool;
+    int sequence = 0;
+    for (auto _ : state) {
+        auto lease = pool.acquire();
+        lease.setCode(1);
+        lease.setData(kData);
+        lease.setInt(keys[0].c_str(), ++sequence);
+        for (std::size_t i = 1; i < keys.size(); ++i) {
+            lease.setLong(keys[i].c_str(), static_cast<long>(i));
+        }
+        lease.publish(kEvent);
+    }
+    const auto stats = pool.stats();
+    state.counters["written_per_publish"] = static_cast<double>(stats.written) / state.iterations();
+    state.counters["created"] = static_cast<double>(stats.created);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PublishPooled)->Arg(2)->Arg(8)->Arg(32);
+
+// 同一个 Lease 连续发布
+void BM_PublishLease(benchmark::State &state) {
+    const auto keys = Keys(static_cast<std::size_t>(state.range(0)));
+    PublishPool pool;
+    int sequence = 0;
+    {
+        auto lease = pool.acquire();
+        for (auto _ : state) {
+            lease.setCode(1);
+            lease.setData(kData);
+            lease.setInt(keys[0].c_str(), ++sequence);
+            for (std::size_t i = 1; i < keys.size(); ++i) {
+                lease.setLong(keys[i].c_str(), static_cast<long>(i));
+            }
+            lease.publish(kEvent);
+        }
+    }
+    const auto stats = pool.stats();
+    state.counters["written_per_publish"] = static_cast<double>(stats.written) / state.iterations();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PublishLease)->Arg(2)->Arg(8)->Arg(32);
+
+// 多个线程共用一个池
+void BM_PublishPooledShared(benchmark::State &state) {
+    static PublishPool pool;
+    const auto keys = Keys(8);
+    int sequence = 0;
+    for (auto _ : state) {
+        auto lease = pool.acquire();
+        lease.setCode(1);
+        lease.setInt(keys[0].c_str(), ++sequence);
+        for (std::size_t i = 1; i < keys.size(); ++i) {
+            lease.setLong(keys[i].c_str(), static_cast<long>(i));
+        }
+        lease.publish(kEvent);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PublishPooledShared)->ThreadRange(1, 8);
+
+} // namespace
@@ -0,0 +1,126 @@
+// 事件日志的记录和回放开销：回调里记一条的代价，以及最快速度回放时每条的代价
+// 日志写到 /tmp，每条带 code、data 和 4 个参数；重新发布经过 bench/stub 的回环总线投递给订阅者
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <commonevent_stub.h>
+
+#include "replay.h"
+
+namespace {
+
+using namespace OHOS::common::event;
+
+const char kEvent[] = "usual.event.bench.REPLAY";
+const char kLogPath[] = "/tmp/commev_replay_bench.log";
+constexpr int kLogEvents = 1024;
+
+const std::vector<ParamKey> &Keys() {
+    static const std::vector<ParamKey> keys{{"sequence", ParamType::Int},
+                                            {"timestamp", ParamType::Long},
+                                            {"samples", ParamType::DoubleArray},
+                                            {"vendor", ParamType::CharArray}};
+    return keys;
+}
+
+void Fill(Parameters &params, int sequence) {
+    const double samples[] = {0.5, 1.5, 2.5, 3.5};
+    params.setInt("sequence", sequence);
+    params.setLong("timestamp", 1700000000L + sequence);
+    params.setDoubleArray("samples", samples, 4);
+    params.setCharArray("vendor", "vendor-a", 8);
+}
+
+// 收到的事件由回调记入日志，不计发布和投递，只计 capture 包装的开销
+void BM_CaptureAppend(benchmark::State &state) {
+    PublishInfo info(false);
+    info.setCode(1);
+    info.setData("usb=attached", 12);
+    Parameters params;
+    Fill(params, 0);
+    info.setParameters(params);
+    const char *events[] = {kEvent};
+    SubscribeInfo subscribeInfo(events, 1);
+    EventLogWriter writer(kLogPath);
+    // 借 stub 的订阅者拿到一个真实的 RcvData，在回调线程里反复记录
+    std::atomic<bool> done{false};
+    auto captured = writer.capture(Keys(), [](const RcvData &) {});
+    Subscriber subscriber(&subscribeInfo, [&](const RcvData &data, CommonEvent_Subscriber *self) {
+        for (auto _ : state) {
+            captured(data, self);
+        }
+        done.store(true);
+    });
+    subscriber.subscribe();
+    Publish(kEvent, info);
+    while (!done.load()) {
+        std::this_thread::yield();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CaptureAppend)->UseRealTime();
+
+void WriteLog() {
+    EventLogWriter writer(kLogPath);
+    EventRecord record;
+    const char *events[] = {kEvent};
+    SubscribeInfo subscribeInfo(events, 1);
+    std::atomic<int> received{0};
+    Subscriber subscriber(&subscribeInfo, [&](const RcvData &data) {
+        record.assign(data, Keys());
+        writer.append(record, std::chrono::microseconds(received.fetch_add(1) * 100));
+    });
+    subscriber.subscribe();
+    for (int i = 0; i < kLogEvents; ++i) {
+        PublishInfo info(false);
+        Parameters params;
+        Fill(params, i);
+        info.setCode(i);
+        info.setParameters(params);
+        Publish(kEvent, info);
+    }
+    CommonEventStub_Flush();
+}
+
+// 最快速度回放，直接交给处理函数
+void BM_ReplayMax(benchmark::State &state) {
+    WriteLog();
+    EventLogReader reader(kLogPath);
+    std::int64_t sum = 0;
+    for (auto _ : state) {
+        reader.rewind();
+        Replay(reader, [&sum](const EventRecord &record) { sum += record.getInt("sequence", 0); }, {0});
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * kLogEvents);
+}
+BENCHMARK(BM_ReplayMax);
+
+// 最快速度重新发布，等订阅者全部收到
+void BM_RepublishMax(benchmark::State &state) {
+    WriteLog();
+    EventLogReader reader(kLogPath);
+    PublishPool pool;
+    const char *events[] = {kEvent};
+    SubscribeInfo subscribeInfo(events, 1);
+    std::atomic<std::int64_t> received{0};
+    Subscriber subscriber(&subscribeInfo, [&received](const RcvData &) { received.fetch_add(1); });
+    subscriber.subscribe();
+    std::int64_t expected = 0;
+    for (auto _ : state) {
+        reader.rewind();
+        Republish(reader, pool, {0});
+        expected += kLogEvents;
+        while (received.load() < expected) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kLogEvents);
+}
+BENCHMARK(BM_RepublishMax)->UseRealTime();
+
+} // namespace
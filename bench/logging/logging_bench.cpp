@@ -0,0 +1,351 @@
+// hilogpp 日志路径的基准测试，hilog 由 bench/stub 中的桩实现代替
+// 每个用例报告：
+//   items_per_second   每秒输出的记录数
+//   p50_ns/p99_ns      单条记录的延迟分位数，每16条采样一次
+//   allocs_per_record  每条记录平均的堆分配次数
+// 输出 JSON：logging_bench --benchmark_out=result.json --benchmark_out_format=json
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "hilog_async_sink.h"
+#include "hilog_deferred.h"
+#include "hilog_mmap_sink.h"
+#include "hilog_ratelimit.h"
+#include "hilogpp.h"
+
+namespace {
+
+thread_local std::size_t allocations = 0;
+
+void *Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+    ++allocations;
+    size = size ? size : 1;
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    void *p = nullptr;
+    return ::posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+}
+
+void *AllocateOrThrow(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    if (void *p = Allocate(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+// 统计当前线程的堆分配次数。普通、数组、对齐和 nothrow 形式要一起替换，
+// 否则编译器会把库里的 new 和这里的 delete 配对，报 -Wmismatched-new-delete
+void *operator new(std::size_t size) { return AllocateOrThrow(size); }
+void *operator new[](std::size_t size) { return AllocateOrThrow(size); }
+void *operator new(std::size_t size, std::align_val_t align) {
+    return AllocateOrThrow(size, static_cast<std::size_t>(align));
+}
+void *operator new[](std::size_t size, std::align_val_t align) {
+    return AllocateOrThrow(size, static_cast<std::size_t>(align));
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return Allocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return Allocate(size); }
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+    return Allocate(size, static_cast<std::size_t>(align));
+}
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+    return Allocate(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+
+namespace {
+
+using namespace OHOS;
+
+// 丢弃所有记录，只测前端的格式化开销
+class NullSink : public LogSink {
+public:
+    void write(LogLevel, unsigned int, const char *, const char *, std::size_t) override {}
+};
+
+NullSink nullSink;
+
+// 驱动循环并统计延迟分位数和分配次数
+template <typename Record> void Measure(benchmark::State &state, Record &&record) {
+    constexpr std::size_t kSampleMask = 15;
+    std::vector<std::int64_t> samples;
+    samples.reserve(1 << 16);
+    std::size_t count = 0;
+    const std::size_t allocsBefore = allocations;
+    for (auto _ : state) {
+        if ((++count & kSampleMask) == 0 && samples.size() < samples.capacity()) {
+            const auto begin = std::chrono::steady_clock::now();
+            record();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        } else {
+            record();
+        }
+    }
+    const std::size_t allocs = allocations - allocsBefore;
+
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) {
+        return samples.empty() ? 0.0 : static_cast<double>(samples[static_cast<std::size_t>(p * (samples.size() - 1))]);
+    };
+    state.counters["p50_ns"] = benchmark::Counter(percentile(0.50), benchmark::Counter::kAvgThreads);
+    state.counters["p99_ns"] = benchmark::Counter(percentile(0.99), benchmark::Counter::kAvgThreads);
+    state.counters["allocs_per_record"] = benchmark::Counter(
+        count ? static_cast<double>(allocs) / count : 0.0, benchmark::Counter::kAvgThreads);
+    state.SetItemsProcessed(state.iterations());
+}
+
+std::string Payload(std::size_t len) {
+    std::string text;
+    while (text.size() < len) {
+        text += "abcdefghijklmnopqrstuvwxyz0123456789";
+    }
+    text.resize(len);
+    return text;
+}
+
+// ---- 输出端：同步 / 异步 / 崩溃日志环 ----
+
+std::unique_ptr<AsyncLogSink> asyncSink;
+std::uint64_t asyncDroppedBefore = 0;
+std::atomic<int> sinkFinished{0};
+std::unique_ptr<MmapRingSink> ringSink;
+std::string ringPath;
+
+void UseNullSink(const benchmark::State &) { SetLogSink(&nullSink); }
+void UseHiLogSink(const benchmark::State &) { SetLogSink(nullptr); }
+
+template <OverflowPolicy Policy> void UseAsyncSink(const benchmark::State &) {
+    AsyncLogOptions options;
+    options.capacity = 4096;
+    options.policy = Policy;
+    asyncSink.reset(new AsyncLogSink(HiLogSink::Instance(), options));
+    SetLogSink(asyncSink.get());
+    asyncDroppedBefore = asyncSink->dropped();
+    sinkFinished = 0;
+}
+
+void StopAsyncSink(const benchmark::State &) {
+    SetLogSink(nullptr);
+    asyncSink.reset();
+}
+
+void UseRingSink(const benchmark::State &) {
+    ringPath = "/tmp/hilogpp_bench_ring." + std::to_string(::getpid());
+    ringSink.reset(new MmapRingSink(ringPath, 1 << 20, nullSink));
+    SetLogSink(ringSink.get());
+}
+
+void StopRingSink(const benchmark::State &) {
+    SetLogSink(nullptr);
+    ringSink.reset();
+    std::remove(ringPath.c_str());
+}
+
+// ---- 缓冲区大小 × 记录长度，超过缓冲区的记录会被分片 ----
+
+template <std::size_t N> void BM_StreamBufSize(benchmark::State &state) {
+    const std::string payload = Payload(static_cast<std::size_t>(state.range(0)));
+    OHLogStream<N> stream(LogTag::Default(), LOG_INFO);
+    Measure(state, [&] { stream << payload << std::endl; });
+}
+BENCHMARK_TEMPLATE(BM_StreamBufSize, 128)->RangeMultiplier(4)->Range(16, 4096)->Setup(UseHiLogSink);
+BENCHMARK_TEMPLATE(BM_StreamBufSize, 512)->RangeMultiplier(4)->Range(16, 4096)->Setup(UseHiLogSink);
+BENCHMARK_TEMPLATE(BM_StreamBufSize, 1024)->RangeMultiplier(4)->Range(16, 4096)->Setup(UseHiLogSink);
+BENCHMARK_TEMPLATE(BM_StreamBufSize, 4096)->RangeMultiplier(4)->Range(16, 4096)->Setup(UseHiLogSink);
+
+// ---- 各前端，输出端丢弃记录，只比较格式化 ----
+
+void BM_CoutEndl(benchmark::State &state) {
+    int value = 0;
+    Measure(state, [&] { OHOS::cout << "transfer ep=" << 0x81 << " len=" << ++value << std::endl; });
+}
+BENCHMARK(BM_CoutEndl)->Setup(UseNullSink)->Teardown(UseHiLogSink)->ThreadRange(1, 8);
+
+void BM_StreamMacro(benchmark::State &state) {
+    int value = 0;
+    Measure(state, [&] { HILOGPP(INFO) << "transfer ep=" << 0x81 << " len=" << ++value; });
+}
+BENCHMARK(BM_StreamMacro)->Setup(UseNullSink)->Teardown(UseHiLogSink)->ThreadRange(1, 8);
+
+void BM_FmtMacro(benchmark::State &state) {
+    int value = 0;
+    Measure(state, [&] { HILOGPP_FMT(INFO, "transfer ep={} len={}", hilogpp::hex(0x81), ++value); });
+}
+BENCHMARK(BM_FmtMacro)->Setup(UseNullSink)->Teardown(UseHiLogSink)->ThreadRange(1, 8);
+
+// 字符串和十六进制字节串两种写法的对比，长度同 BM_FmtString/BM_FmtHexBytes
+void BM_StreamString(benchmark::State &state) {
+    const std::string payload = Payload(static_cast<std::size_t>(state.range(0)));
+    Measure(state, [&] { HILOGPP(INFO) << "payload " << payload; });
+}
+BENCHMARK(BM_StreamString)->RangeMultiplier(4)->Range(16, 4096)->Setup(UseNullSink)->Teardown(UseHiLogSink);
+
+void BM_StreamHexBytes(benchmark::State &state) {
+    const std::string payload = Payload(static_cast<std::size_t>(state.range(0)));
+    Measure(state, [&] { HILOGPP(INFO) << "data " << hilogpp::HexBytes{payload.data(), payload.size()}; });
+}
+BENCHMARK(BM_StreamHexBytes)->RangeMultiplier(4)->Range(16, 1024)->Setup(UseNullSink)->Teardown(UseHiLogSink);
+
+void BM_FmtString(benchmark::State &state) {
+    const std::string payload = Payload(static_cast<std::size_t>(state.range(0)));
+    Measure(state, [&] { HILOGPP_FMT(INFO, "payload {}", payload); });
+}
+BENCHMARK(BM_FmtString)->RangeMultiplier(4)->Range(16, 4096)->Setup(UseNullSink)->Teardown(UseHiLogSink);
+
+void BM_FmtHexBytes(benchmark::State &state) {
+    const std::string payload = Payload(static_cast<std::size_t>(state.range(0)));
+    Measure(state, [&] { HILOGPP_FMT(INFO, "data {}", hilogpp::HexBytes{payload.data(), payload.size()}); });
+}
+BENCHMARK(BM_FmtHexBytes)->RangeMultiplier(4)->Range(16, 1024)->Setup(UseNullSink)->Teardown(UseHiLogSink);
+
+// 延迟格式化在缓冲区满时直接丢弃，后台线程跟不上时大部分记录会被丢掉，
+// 所以 items_per_second 只算真正输出的记录，另报丢弃的条数和比例
+std::atomic<std::uint64_t> deferredDroppedBefore{0};
+std::atomic<int> deferredFinished{0};
+
+void UseDeferred(const benchmark::State &state) {
+    UseNullSink(state);
+    // 只在第一次用到 HILOGPP_DEFER 之前生效，每个线程 4 MiB 可以吸收几十万条的突发
+    hilogpp::DeferredLogOptions options;
+    options.threadBufferSize = 4 << 20;
+    hilogpp::ConfigureDeferredLogging(options);
+    deferredDroppedBefore = hilogpp::DeferredDropped();
+    deferredFinished = 0;
+}
+
+void BM_Deferred(benchmark::State &state) {
+    int value = 0;
+    Measure(state, [&] { HILOGPP_DEFER(INFO, "transfer ep={} len={}", hilogpp::hex(0x81), ++value); });
+    // 各线程的迭代次数加起来是写入的总条数，由 0 号线程等其他线程都写完后统计
+    deferredFinished.fetch_add(1);
+    if (state.thread_index() != 0) {
+        state.SetItemsProcessed(0);
+        return;
+    }
+    while (deferredFinished.load() != state.threads()) {
+        std::this_thread::yield();
+    }
+    hilogpp::FlushDeferredLogging();
+    const auto written = static_cast<std::uint64_t>(state.iterations()) * state.threads();
+    const std::uint64_t dropped = hilogpp::DeferredDropped() - deferredDroppedBefore;
+    state.SetItemsProcessed(static_cast<std::int64_t>(written - dropped));
+    state.counters["dropped"] = static_cast<double>(dropped);
+    state.counters["dropped_ratio"] = written ? static_cast<double>(dropped) / written : 0.0;
+}
+BENCHMARK(BM_Deferred)->Setup(UseDeferred)->Teardown(UseHiLogSink)->ThreadRange(1, 8);
+
+// ---- 不输出的语句：编译期裁掉、运行时关闭的标签、限流 ----
+
+void BM_EmptyLoop(benchmark::State &state) {
+    int value = 0;
+    Measure(state, [&] { benchmark::DoNotOptimize(++value); });
+}
+BENCHMARK(BM_EmptyLoop);
+
+void BM_CompiledOut(benchmark::State &state) {
+    int value = 0;
+    Measure(state, [&] {
+        benchmark::DoNotOptimize(++value);
+        HILOGPP(DEBUG) << "value=" << value;
+    });
+}
+BENCHMARK(BM_CompiledOut);
+
+void BM_DisabledTag(benchmark::State &state) {
+    static LogTag &tag = LogTag::Intern(0x1, "bench.disabled");
+    tag.setEnabled(false);
+    int value = 0;
+    Measure(state, [&] { HILOGPP_TAG(tag, INFO) << "value=" << ++value; });
+}
+BENCHMARK(BM_DisabledTag)->ThreadRange(1, 8);
+
+void BM_EveryN(benchmark::State &state) {
+    int value = 0;
+    Measure(state, [&] { HILOGPP_EVERY_N(INFO, 1000) << "value=" << ++value; });
+}
+BENCHMARK(BM_EveryN)->Setup(UseNullSink)->Teardown(UseHiLogSink)->ThreadRange(1, 8);
+
+// ---- 输出端：写入线程看到的开销 ----
+
+void BM_Sink(benchmark::State &state) {
+    const std::string payload = Payload(static_cast<std::size_t>(state.range(0)));
+    Measure(state, [&] { HILOGPP(INFO) << payload; });
+    if (!asyncSink) {
+        return;
+    }
+    // 异步输出端队列满时会丢弃记录，同 BM_Deferred，items_per_second 只算没被丢弃的，由 0 号线程统一统计
+    sinkFinished.fetch_add(1);
+    if (state.thread_index() != 0) {
+        state.SetItemsProcessed(0);
+        return;
+    }
+    while (sinkFinished.load() != state.threads()) {
+        std::this_thread::yield();
+    }
+    const auto written = static_cast<std::uint64_t>(state.iterations()) * state.threads();
+    const std::uint64_t dropped = asyncSink->dropped() - asyncDroppedBefore;
+    state.SetItemsProcessed(static_cast<std::int64_t>(written - dropped));
+    state.counters["dropped"] = static_cast<double>(dropped);
+    state.counters["dropped_ratio"] = written ? static_cast<double>(dropped) / written : 0.0;
+}
+BENCHMARK(BM_Sink)->Name("BM_Sink/sync")->Arg(64)->Arg(512)->Setup(UseHiLogSink)->ThreadRange(1, 8);
+BENCHMARK(BM_Sink)
+    ->Name("BM_Sink/async_drop_newest")
+    ->Arg(64)
+    ->Arg(512)
+    ->Setup(UseAsyncSink<OverflowPolicy::DropNewest>)
+    ->Teardown(StopAsyncSink)
+    ->ThreadRange(1, 8);
+BENCHMARK(BM_Sink)
+    ->Name("BM_Sink/async_drop_oldest")
+    ->Arg(64)
+    ->Arg(512)
+    ->Setup(UseAsyncSink<OverflowPolicy::DropOldest>)
+    ->Teardown(StopAsyncSink)
+    ->ThreadRange(1, 8);
+BENCHMARK(BM_Sink)
+    ->Name("BM_Sink/async_block")
+    ->Arg(64)
+    ->Arg(512)
+    ->Setup(UseAsyncSink<OverflowPolicy::Block>)
+    ->Teardown(StopAsyncSink)
+    ->ThreadRange(1, 8);
+BENCHMARK(BM_Sink)
+    ->Name("BM_Sink/mmap_ring")
+    ->Arg(64)
+    ->Arg(512)
+    ->Setup(UseRingSink)
+    ->Teardown(StopRingSink)
+    ->ThreadRange(1, 8);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,729 @@
+// libohcommonevent.so 的 Linux 桩实现，链接时代替 NDK 的库
+// 数据结构和 NDK 的行为保持一致：订阅信息、订阅者、发布信息和参数都是堆上的对象，
+// 发布时把事件和参数整体拷贝一份，模拟 CES 打包成 Want 的开销。
+// 进程内的回环总线把事件投递给本进程的订阅者：发布时按事件名和发布者包名匹配订阅者，
+// 普通事件和有序事件各由一个投递线程在延迟到期后回调；有序事件按订阅者创建的顺序逐个传递，
+// 订阅者调用 OH_CommonEvent_FinishCommonEvent 或超时后才传给下一个，中途被终止则不再往下传。
+// 不校验权限。
+// 环境变量（也可以用 commonevent_stub.h 中的接口在运行时修改）：
+//   COMMONEVENT_STUB_LATENCY_US=n          发布到收到之间注入的延迟，默认 0
+//   COMMONEVENT_STUB_ORDERED_TIMEOUT_MS=n  有序事件等订阅者结束的超时，默认和 CES 一样为 10000
+#include <BasicServicesKit/oh_commonevent.h>
+#include <commonevent_stub.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+enum class Kind { Int, Long, Bool, Char, Double, IntArray, LongArray, BoolArray, CharArray, DoubleArray };
+
+struct Value {
+    Kind kind;
+    long long integer = 0;
+    double real = 0;
+    std::vector<char> bytes; // 数组元素的原始字节
+};
+
+struct ParametersImpl {
+    std::map<std::string, Value> values;
+};
+
+ParametersImpl *Impl(CommonEvent_Parameters *param) { return static_cast<ParametersImpl *>(param); }
+const ParametersImpl *Impl(const CommonEvent_Parameters *param) { return static_cast<const ParametersImpl *>(param); }
+
+const Value *Find(const CommonEvent_Parameters *param, const char *key, Kind kind) {
+    if (!param || !key) {
+        return nullptr;
+    }
+    const auto &values = Impl(param)->values;
+    auto it = values.find(key);
+    return it != values.end() && it->second.kind == kind ? &it->second : nullptr;
+}
+
+CommonEvent_ErrCode SetScalar(CommonEvent_Parameters *param, const char *key, Kind kind, long long integer,
+                              double real = 0) {
+    if (!param || !key) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    Value &value = Impl(param)->values[key];
+    value.kind = kind;
+    value.integer = integer;
+    value.real = real;
+    value.bytes.clear();
+    return COMMONEVENT_ERR_OK;
+}
+
+template <typename T>
+CommonEvent_ErrCode SetArray(CommonEvent_Parameters *param, const char *key, Kind kind, const T *array, size_t num) {
+    if (!param || !key || (!array && num > 0)) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    Value &value = Impl(param)->values[key];
+    value.kind = kind;
+    const char *begin = reinterpret_cast<const char *>(array);
+    value.bytes.assign(begin, begin + num * sizeof(T));
+    return COMMONEVENT_ERR_OK;
+}
+
+template <typename T> int32_t GetArray(const CommonEvent_Parameters *param, const char *key, Kind kind, T **array) {
+    const Value *value = Find(param, key, kind);
+    if (!value || value->bytes.empty()) {
+        *array = nullptr;
+        return 0;
+    }
+    *array = reinterpret_cast<T *>(const_cast<char *>(value->bytes.data()));
+    return static_cast<int32_t>(value->bytes.size() / sizeof(T));
+}
+
+} // namespace
+
+struct CommonEvent_SubscribeInfo {
+    std::vector<std::string> events;
+    std::string permission;
+    std::string bundleName;
+};
+
+struct CommonEvent_PublishInfo {
+    bool ordered = false;
+    std::string bundleName;
+    std::vector<std::string> permissions;
+    int32_t code = 0;
+    std::string data;
+    const ParametersImpl *parameters = nullptr;
+};
+
+struct CommonEvent_RcvData {
+    std::string event;
+    std::string bundleName;
+    int32_t code = 0;
+    std::string data;
+    ParametersImpl parameters;
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 正在传递的有序事件，code 和 data 可以被前面的订阅者修改后传给后面的订阅者
+struct OrderedEvent {
+    int32_t code = 0;
+    std::string data;
+    bool aborted = false;
+    bool finished = false;
+};
+
+struct SubscriberImpl {
+    CommonEvent_SubscribeInfo info;
+    CommonEvent_ReceiveCallback callback;
+    uint64_t id = 0;
+    bool subscribed = false;
+    bool orphaned = false;           // 在自己的回调里被销毁，回调返回后由投递线程释放
+    uint32_t busy = 0;               // 正在执行的回调数
+    OrderedEvent *ordered = nullptr; // 收到后还没结束的有序事件
+};
+
+struct Delivery {
+    Clock::time_point at;
+    std::shared_ptr<const CommonEvent_RcvData> data;
+    std::vector<uint64_t> targets; // 发布时匹配到的订阅者
+};
+
+// 当前线程正在回调的订阅者
+thread_local const SubscriberImpl *tlsReceiving = nullptr;
+
+uint32_t EnvOr(const char *name, uint32_t fallback) {
+    const char *value = std::getenv(name);
+    return value && *value ? static_cast<uint32_t>(std::strtoul(value, nullptr, 10)) : fallback;
+}
+
+// 条件变量和 sleep 的唤醒误差有几十微秒，最后一小段用 yield 等
+void WaitUntil(Clock::time_point at) {
+    constexpr auto kSpin = std::chrono::microseconds(100);
+    for (auto now = Clock::now(); now < at; now = Clock::now()) {
+        if (at - now > 2 * kSpin) {
+            std::this_thread::sleep_for(at - now - kSpin);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// 按 CES 的方式把发布的内容整体打包一份
+void Marshal(CommonEvent_RcvData &data, const char *event, const CommonEvent_PublishInfo *info) {
+    data.event = event;
+    if (info) {
+        data.bundleName = info->bundleName;
+        data.code = info->code;
+        data.data = info->data;
+        if (info->parameters) {
+            data.parameters = *info->parameters;
+        }
+    }
+}
+
+// 一个投递线程，按发布顺序处理，到期后才投递
+class Worker {
+public:
+    using Handler = std::function<void(const Delivery &)>;
+
+    explicit Worker(Handler handler) : handler_(std::move(handler)), thread_([this] { run(); }) {}
+
+    void push(Delivery delivery) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(delivery));
+        }
+        ready_.notify_one();
+    }
+
+    // 不能在回调里调用
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return queue_.empty() && !running_; });
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            ready_.wait(lock, [this] { return !queue_.empty(); });
+            Delivery delivery = std::move(queue_.front());
+            queue_.pop_front();
+            running_ = true;
+            lock.unlock();
+            WaitUntil(delivery.at);
+            handler_(delivery);
+            lock.lock();
+            running_ = false;
+            idle_.notify_all();
+        }
+    }
+
+    Handler handler_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable idle_;
+    std::deque<Delivery> queue_;
+    bool running_ = false;
+    std::thread thread_; // 最后初始化，线程启动时其余成员都已就绪
+};
+
+class LoopbackBus {
+public:
+    // 不析构：静态对象中的订阅者可能在进程退出时才销毁
+    static LoopbackBus &Instance() {
+        static LoopbackBus *bus = new LoopbackBus;
+        return *bus;
+    }
+
+    void setLatency(uint32_t microseconds) { latency_.store(microseconds); }
+    void setOrderedTimeout(uint32_t milliseconds) { orderedTimeout_.store(milliseconds); }
+
+    void flush() {
+        unordered_.flush();
+        ordered_.flush();
+    }
+
+    SubscriberImpl *create(const CommonEvent_SubscribeInfo &info, CommonEvent_ReceiveCallback callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto *subscriber = new SubscriberImpl{info, callback, ++nextId_};
+        live_.emplace(subscriber->id, subscriber);
+        return subscriber;
+    }
+
+    // 等该订阅者正在执行的回调返回后再释放，它持有的有序事件视为结束
+    void destroy(SubscriberImpl *subscriber) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        live_.erase(subscriber->id);
+        release(*subscriber);
+        if (tlsReceiving == subscriber) {
+            subscriber->orphaned = true;
+            return;
+        }
+        done_.wait(lock, [subscriber] { return subscriber->busy == 0; });
+        delete subscriber;
+    }
+
+    void setSubscribed(const SubscriberImpl *subscriber, bool subscribed) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const_cast<SubscriberImpl *>(subscriber)->subscribed = subscribed;
+    }
+
+    CommonEvent_ErrCode publish(const char *event, const CommonEvent_PublishInfo *info) {
+        auto data = std::make_shared<CommonEvent_RcvData>();
+        Marshal(*data, event, info);
+        Delivery delivery{Clock::now() + std::chrono::microseconds(latency_.load()), nullptr, match(*data)};
+        if (delivery.targets.empty()) {
+            return COMMONEVENT_ERR_OK;
+        }
+        delivery.data = std::move(data);
+        (info && info->ordered ? ordered_ : unordered_).push(std::move(delivery));
+        return COMMONEVENT_ERR_OK;
+    }
+
+    // 对订阅者当前持有的有序事件执行 fn，没有时返回 fallback
+    template <typename Fn, typename R> R withOrdered(const CommonEvent_Subscriber *subscriber, R fallback, Fn &&fn) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto *impl = const_cast<SubscriberImpl *>(static_cast<const SubscriberImpl *>(subscriber));
+        return impl && impl->ordered ? fn(*impl) : fallback;
+    }
+
+    bool finish(CommonEvent_Subscriber *subscriber) {
+        return withOrdered(subscriber, false, [this](SubscriberImpl &impl) {
+            release(impl);
+            return true;
+        });
+    }
+
+private:
+    LoopbackBus()
+        : latency_(EnvOr("COMMONEVENT_STUB_LATENCY_US", 0)),
+          orderedTimeout_(EnvOr("COMMONEVENT_STUB_ORDERED_TIMEOUT_MS", 10000)),
+          unordered_([this](const Delivery &delivery) { deliver(delivery); }),
+          ordered_([this](const Delivery &delivery) { deliverOrdered(delivery); }) {}
+
+    static bool Matches(const SubscriberImpl &subscriber, const CommonEvent_RcvData &data) {
+        if (!subscriber.subscribed) {
+            return false;
+        }
+        if (!subscriber.info.bundleName.empty() && subscriber.info.bundleName != data.bundleName) {
+            return false;
+        }
+        for (const auto &event : subscriber.info.events) {
+            if (event == data.event) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<uint64_t> match(const CommonEvent_RcvData &data) {
+        std::vector<uint64_t> targets;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &entry : live_) {
+            if (Matches(*entry.second, data)) {
+                targets.push_back(entry.first);
+            }
+        }
+        return targets;
+    }
+
+    // 取出还存在且仍在订阅的订阅者，标记为正在回调
+    SubscriberImpl *enter(uint64_t id) {
+        auto it = live_.find(id);
+        if (it == live_.end() || !it->second->subscribed) {
+            return nullptr;
+        }
+        ++it->second->busy;
+        return it->second;
+    }
+
+    void leave(SubscriberImpl *subscriber) {
+        --subscriber->busy;
+        if (subscriber->orphaned) {
+            delete subscriber;
+        } else {
+            done_.notify_all();
+        }
+    }
+
+    void release(SubscriberImpl &subscriber) {
+        if (subscriber.ordered) {
+            subscriber.ordered->finished = true;
+            subscriber.ordered = nullptr;
+            done_.notify_all();
+        }
+    }
+
+    static void Invoke(SubscriberImpl *subscriber, const CommonEvent_RcvData *data) {
+        tlsReceiving = subscriber;
+        subscriber->callback(data);
+        tlsReceiving = nullptr;
+    }
+
+    void deliver(const Delivery &delivery) {
+        for (uint64_t id : delivery.targets) {
+            SubscriberImpl *subscriber;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                subscriber = enter(id);
+            }
+            if (!subscriber) {
+                continue;
+            }
+            Invoke(subscriber, delivery.data.get());
+            std::lock_guard<std::mutex> lock(mutex_);
+            leave(subscriber);
+        }
+    }
+
+    // 逐个传递，每传给下一个订阅者都是一次 IPC，再注入一次延迟
+    void deliverOrdered(const Delivery &delivery) {
+        OrderedEvent event{delivery.data->code, delivery.data->data};
+        bool first = true;
+        for (uint64_t id : delivery.targets) {
+            if (!std::exchange(first, false)) {
+                WaitUntil(Clock::now() + std::chrono::microseconds(latency_.load()));
+            }
+            CommonEvent_RcvData data;
+            SubscriberImpl *subscriber;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (event.aborted) {
+                    break;
+                }
+                subscriber = enter(id);
+                if (!subscriber) {
+                    continue;
+                }
+                event.finished = false;
+                subscriber->ordered = &event;
+                data = *delivery.data;
+                data.code = event.code;
+                data.data = event.data;
+            }
+            Invoke(subscriber, &data);
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait_for(lock, std::chrono::milliseconds(orderedTimeout_.load()), [&event] { return event.finished; });
+            if (subscriber->ordered == &event) {
+                subscriber->ordered = nullptr;
+            }
+            leave(subscriber);
+        }
+    }
+
+    std::atomic<uint32_t> latency_;
+    std::atomic<uint32_t> orderedTimeout_;
+    std::mutex mutex_;
+    std::condition_variable done_; // 回调返回或有序事件结束
+    std::map<uint64_t, SubscriberImpl *> live_; // 按创建顺序，也是有序事件的传递顺序
+    uint64_t nextId_ = 0;
+    Worker unordered_;
+    Worker ordered_;
+};
+
+} // namespace
+
+extern "C" {
+
+CommonEvent_SubscribeInfo *OH_CommonEvent_CreateSubscribeInfo(const char *events[], int32_t eventsNum) {
+    if (!events || eventsNum <= 0) {
+        return nullptr;
+    }
+    auto *info = new CommonEvent_SubscribeInfo;
+    for (int32_t i = 0; i < eventsNum; ++i) {
+        if (events[i]) {
+            info->events.emplace_back(events[i]);
+        }
+    }
+    return info;
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetPublisherPermission(CommonEvent_SubscribeInfo *info, const char *permission) {
+    if (!info) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    info->permission = permission ? permission : "";
+    return COMMONEVENT_ERR_OK;
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetPublisherBundleName(CommonEvent_SubscribeInfo *info, const char *bundleName) {
+    if (!info) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    info->bundleName = bundleName ? bundleName : "";
+    return COMMONEVENT_ERR_OK;
+}
+
+void OH_CommonEvent_DestroySubscribeInfo(CommonEvent_SubscribeInfo *info) { delete info; }
+
+CommonEvent_Subscriber *OH_CommonEvent_CreateSubscriber(const CommonEvent_SubscribeInfo *info,
+                                                        CommonEvent_ReceiveCallback callback) {
+    if (!info || !callback) {
+        return nullptr;
+    }
+    return LoopbackBus::Instance().create(*info, callback);
+}
+
+void OH_CommonEvent_DestroySubscriber(CommonEvent_Subscriber *subscriber) {
+    if (subscriber) {
+        LoopbackBus::Instance().destroy(static_cast<SubscriberImpl *>(subscriber));
+    }
+}
+
+CommonEvent_ErrCode OH_CommonEvent_Subscribe(const CommonEvent_Subscriber *subscriber) {
+    if (!subscriber) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    LoopbackBus::Instance().setSubscribed(static_cast<const SubscriberImpl *>(subscriber), true);
+    return COMMONEVENT_ERR_OK;
+}
+
+CommonEvent_ErrCode OH_CommonEvent_UnSubscribe(const CommonEvent_Subscriber *subscriber) {
+    if (!subscriber) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    LoopbackBus::Instance().setSubscribed(static_cast<const SubscriberImpl *>(subscriber), false);
+    return COMMONEVENT_ERR_OK;
+}
+
+const char *OH_CommonEvent_GetEventFromRcvData(const CommonEvent_RcvData *rcvData) {
+    return rcvData ? rcvData->event.c_str() : nullptr;
+}
+
+int32_t OH_CommonEvent_GetCodeFromRcvData(const CommonEvent_RcvData *rcvData) { return rcvData ? rcvData->code : 0; }
+
+const char *OH_CommonEvent_GetDataStrFromRcvData(const CommonEvent_RcvData *rcvData) {
+    return rcvData ? rcvData->data.c_str() : nullptr;
+}
+
+const char *OH_CommonEvent_GetBundleNameFromRcvData(const CommonEvent_RcvData *rcvData) {
+    return rcvData ? rcvData->bundleName.c_str() : nullptr;
+}
+
+const CommonEvent_Parameters *OH_CommonEvent_GetParametersFromRcvData(const CommonEvent_RcvData *rcvData) {
+    return rcvData ? &rcvData->parameters : nullptr;
+}
+
+bool OH_CommonEvent_HasKeyInParameters(const CommonEvent_Parameters *para, const char *key) {
+    return para && key && Impl(para)->values.count(key) > 0;
+}
+
+int OH_CommonEvent_GetIntFromParameters(const CommonEvent_Parameters *para, const char *key, const int defaultValue) {
+    const Value *value = Find(para, key, Kind::Int);
+    return value ? static_cast<int>(value->integer) : defaultValue;
+}
+
+int32_t OH_CommonEvent_GetIntArrayFromParameters(const CommonEvent_Parameters *para, const char *key, int **array) {
+    return GetArray(para, key, Kind::IntArray, array);
+}
+
+long OH_CommonEvent_GetLongFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                          const long defaultValue) {
+    const Value *value = Find(para, key, Kind::Long);
+    return value ? static_cast<long>(value->integer) : defaultValue;
+}
+
+int32_t OH_CommonEvent_GetLongArrayFromParameters(const CommonEvent_Parameters *para, const char *key, long **array) {
+    return GetArray(para, key, Kind::LongArray, array);
+}
+
+bool OH_CommonEvent_GetBoolFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                          const bool defaultValue) {
+    const Value *value = Find(para, key, Kind::Bool);
+    return value ? value->integer != 0 : defaultValue;
+}
+
+int32_t OH_CommonEvent_GetBoolArrayFromParameters(const CommonEvent_Parameters *para, const char *key, bool **array) {
+    return GetArray(para, key, Kind::BoolArray, array);
+}
+
+char OH_CommonEvent_GetCharFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                          const char defaultValue) {
+    const Value *value = Find(para, key, Kind::Char);
+    return value ? static_cast<char>(value->integer) : defaultValue;
+}
+
+int32_t OH_CommonEvent_GetCharArrayFromParameters(const CommonEvent_Parameters *para, const char *key, char **array) {
+    return GetArray(para, key, Kind::CharArray, array);
+}
+
+double OH_CommonEvent_GetDoubleFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                              const double defaultValue) {
+    const Value *value = Find(para, key, Kind::Double);
+    return value ? value->real : defaultValue;
+}
+
+int32_t OH_CommonEvent_GetDoubleArrayFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                                    double **array) {
+    return GetArray(para, key, Kind::DoubleArray, array);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_Publish(const char *event) { return OH_CommonEvent_PublishWithInfo(event, nullptr); }
+
+CommonEvent_ErrCode OH_CommonEvent_PublishWithInfo(const char *event, const CommonEvent_PublishInfo *info) {
+    if (!event) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    return LoopbackBus::Instance().publish(event, info);
+}
+
+CommonEvent_PublishInfo *OH_CommonEvent_CreatePublishInfo(bool ordered) {
+    auto *info = new CommonEvent_PublishInfo;
+    info->ordered = ordered;
+    return info;
+}
+
+void OH_CommonEvent_DestroyPublishInfo(CommonEvent_PublishInfo *info) { delete info; }
+
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoBundleName(CommonEvent_PublishInfo *info, const char *bundleName) {
+    if (!info) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    info->bundleName = bundleName ? bundleName : "";
+    return COMMONEVENT_ERR_OK;
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoPermissions(CommonEvent_PublishInfo *info, const char *permissions[],
+                                                             int32_t num) {
+    if (!info || (!permissions && num > 0)) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    info->permissions.assign(permissions, permissions + num);
+    return COMMONEVENT_ERR_OK;
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoCode(CommonEvent_PublishInfo *info, int32_t code) {
+    if (!info) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    info->code = code;
+    return COMMONEVENT_ERR_OK;
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoData(CommonEvent_PublishInfo *info, const char *data, size_t length) {
+    if (!info || (!data && length > 0)) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    info->data.assign(data ? data : "", length);
+    return COMMONEVENT_ERR_OK;
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoParameters(CommonEvent_PublishInfo *info,
+                                                            CommonEvent_Parameters *param) {
+    if (!info) {
+        return COMMONEVENT_ERR_INVALID_PARAMETER;
+    }
+    // 和 NDK 一样只保存指针，发布时才读取参数
+    info->parameters = Impl(param);
+    return COMMONEVENT_ERR_OK;
+}
+
+CommonEvent_Parameters *OH_CommonEvent_CreateParameters(void) { return new ParametersImpl; }
+
+void OH_CommonEvent_DestroyParameters(CommonEvent_Parameters *param) { delete Impl(param); }
+
+CommonEvent_ErrCode OH_CommonEvent_SetIntToParameters(CommonEvent_Parameters *param, const char *key, int value) {
+    return SetScalar(param, key, Kind::Int, value);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetIntArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                           const int *value, size_t num) {
+    return SetArray(param, key, Kind::IntArray, value, num);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetLongToParameters(CommonEvent_Parameters *param, const char *key, long value) {
+    return SetScalar(param, key, Kind::Long, value);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetLongArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                            const long *value, size_t num) {
+    return SetArray(param, key, Kind::LongArray, value, num);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetBoolToParameters(CommonEvent_Parameters *param, const char *key, bool value) {
+    return SetScalar(param, key, Kind::Bool, value);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetBoolArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                            const bool *value, size_t num) {
+    return SetArray(param, key, Kind::BoolArray, value, num);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetCharToParameters(CommonEvent_Parameters *param, const char *key, char value) {
+    return SetScalar(param, key, Kind::Char, value);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetCharArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                            const char *value, size_t num) {
+    return SetArray(param, key, Kind::CharArray, value, num);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetDoubleToParameters(CommonEvent_Parameters *param, const char *key,
+                                                         double value) {
+    return SetScalar(param, key, Kind::Double, 0, value);
+}
+
+CommonEvent_ErrCode OH_CommonEvent_SetDoubleArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                              const double *value, size_t num) {
+    return SetArray(param, key, Kind::DoubleArray, value, num);
+}
+
+// 以下只对订阅者收到后还没结束的有序事件有效
+bool OH_CommonEvent_IsOrderedCommonEvent(const CommonEvent_Subscriber *subscriber) {
+    return LoopbackBus::Instance().withOrdered(subscriber, false, [](SubscriberImpl &) { return true; });
+}
+
+bool OH_CommonEvent_FinishCommonEvent(CommonEvent_Subscriber *subscriber) {
+    return LoopbackBus::Instance().finish(subscriber);
+}
+
+bool OH_CommonEvent_GetAbortCommonEvent(const CommonEvent_Subscriber *subscriber) {
+    return LoopbackBus::Instance().withOrdered(subscriber, false,
+                                               [](SubscriberImpl &impl) { return impl.ordered->aborted; });
+}
+
+bool OH_CommonEvent_AbortCommonEvent(CommonEvent_Subscriber *subscriber) {
+    return LoopbackBus::Instance().withOrdered(subscriber, false, [](SubscriberImpl &impl) {
+        impl.ordered->aborted = true;
+        return true;
+    });
+}
+
+bool OH_CommonEvent_ClearAbortCommonEvent(CommonEvent_Subscriber *subscriber) {
+    return LoopbackBus::Instance().withOrdered(subscriber, false, [](SubscriberImpl &impl) {
+        impl.ordered->aborted = false;
+        return true;
+    });
+}
+
+int32_t OH_CommonEvent_GetCodeFromSubscriber(const CommonEvent_Subscriber *subscriber) {
+    return LoopbackBus::Instance().withOrdered(subscriber, int32_t{0},
+                                               [](SubscriberImpl &impl) { return impl.ordered->code; });
+}
+
+bool OH_CommonEvent_SetCodeToSubscriber(CommonEvent_Subscriber *subscriber, int32_t code) {
+    return LoopbackBus::Instance().withOrdered(subscriber, false, [code](SubscriberImpl &impl) {
+        impl.ordered->code = code;
+        return true;
+    });
+}
+
+// 返回的字符串在有序事件结束前有效
+const char *OH_CommonEvent_GetDataFromSubscriber(const CommonEvent_Subscriber *subscriber) {
+    return LoopbackBus::Instance().withOrdered(subscriber, "",
+                                               [](SubscriberImpl &impl) { return impl.ordered->data.c_str(); });
+}
+
+bool OH_CommonEvent_SetDataToSubscriber(CommonEvent_Subscriber *subscriber, const char *data, size_t length) {
+    if (!data && length > 0) {
+        return false;
+    }
+    return LoopbackBus::Instance().withOrdered(subscriber, false, [data, length](SubscriberImpl &impl) {
+        impl.ordered->data.assign(data ? data : "", length);
+        return true;
+    });
+}
+
+void CommonEventStub_SetLatency(uint32_t microseconds) { LoopbackBus::Instance().setLatency(microseconds); }
+
+void CommonEventStub_SetOrderedTimeout(uint32_t milliseconds) {
+    LoopbackBus::Instance().setOrderedTimeout(milliseconds);
+}
+
+void CommonEventStub_Flush(void) { LoopbackBus::Instance().flush(); }
+
+} // extern "C"
@@ -0,0 +1,229 @@
+// libddk_base.z.so 和 libusb_ndk.z.so 的 Linux 桩实现，链接时代替 NDK 的库
+// 模拟一个设备：一个配置、一个接口，带一对批量端点 0x81（IN）和 0x01（OUT）。
+// 管道请求和 NDK 一样是同步的：进入时按顺序排队，先等一个往返延迟，各请求的往返可以重叠；
+// 再按排队的顺序、总线带宽串行传输数据部分。IN 端点从排队序号的低 8 位起把缓冲区填满递增的字节，
+// 可以据此检查数据是否按请求进入的顺序到达；OUT 端点只计长度。
+// 共享内存和设备内存映射都是普通的堆内存。不校验权限。
+// 环境变量（也可以用 usb_ddk_stub.h 中的接口在运行时修改）：
+//   USB_DDK_STUB_LATENCY_US=n     每个请求的往返延迟，默认 0
+//   USB_DDK_STUB_BANDWIDTH=n      总线带宽，单位字节/微秒，默认 0 即不限
+#include <ddk/ddk_api.h>
+#include <usb/usb_ddk_api.h>
+#include <usb_ddk_stub.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+constexpr std::uint64_t kDeviceId = (std::uint64_t(1) << 32) | 2; // 总线 1 设备 2
+
+std::uint32_t EnvOr(const char *name, std::uint32_t fallback) {
+    const char *value = std::getenv(name);
+    return value ? static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10)) : fallback;
+}
+
+std::atomic<std::uint32_t> &Latency() {
+    static std::atomic<std::uint32_t> latency{EnvOr("USB_DDK_STUB_LATENCY_US", 0)};
+    return latency;
+}
+
+std::atomic<std::uint32_t> &Bandwidth() {
+    static std::atomic<std::uint32_t> bandwidth{EnvOr("USB_DDK_STUB_BANDWIDTH", 0)};
+    return bandwidth;
+}
+
+// 同一时刻总线上只传一个请求的数据，按请求进入时取得的序号依次传输
+struct Bus {
+    std::mutex mutex;
+    std::condition_variable turn;
+    std::uint64_t queued = 0; // 已排队的请求数，也是下一个请求的序号
+    std::uint64_t served = 0; // 已传输完的请求数
+};
+
+Bus &TheBus() {
+    static Bus bus;
+    return bus;
+}
+
+std::int32_t Transfer(const UsbRequestPipe *pipe, std::uint8_t *address, std::uint32_t length,
+                      std::uint32_t *transferred) {
+    if (!pipe || !address || pipe->interfaceHandle == 0) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    Bus &bus = TheBus();
+    const auto start = std::chrono::steady_clock::now();
+    std::uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(bus.mutex);
+        ticket = bus.queued++;
+    }
+    if (const std::uint32_t latency = Latency().load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(start + std::chrono::microseconds(latency));
+    }
+    {
+        std::unique_lock<std::mutex> lock(bus.mutex);
+        bus.turn.wait(lock, [&bus, ticket] { return bus.served == ticket; });
+        if (const std::uint32_t bandwidth = Bandwidth().load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(length / bandwidth));
+        }
+        if (pipe->endpoint & 0x80) {
+            auto value = static_cast<std::uint8_t>(ticket);
+            for (std::uint32_t i = 0; i < length; ++i) {
+                address[i] = value++;
+            }
+        }
+        ++bus.served;
+    }
+    bus.turn.notify_all();
+    *transferred = length;
+    return USB_DDK_SUCCESS;
+}
+
+UsbDdkEndpointDescriptor gEndpoints[] = {
+    {{7, 5, 0x81, 0x02, 512, 0, 0, 0}, nullptr, 0},
+    {{7, 5, 0x01, 0x02, 512, 0, 0, 0}, nullptr, 0},
+};
+UsbDdkInterfaceDescriptor gAltsetting = {{9, 4, 0, 0, 2, 0xff, 0, 0, 0}, gEndpoints, nullptr, 0};
+UsbDdkInterface gInterface = {1, &gAltsetting};
+
+} // namespace
+
+extern "C" {
+
+void UsbDdkStub_SetLatency(uint32_t microseconds) { Latency().store(microseconds); }
+
+void UsbDdkStub_SetBandwidth(uint32_t bytesPerMicrosecond) { Bandwidth().store(bytesPerMicrosecond); }
+
+DDK_RetCode OH_DDK_CreateAshmem(const uint8_t *name, uint32_t size, DDK_Ashmem **ashmem) {
+    if (!name || size == 0 || !ashmem) {
+        return DDK_INVALID_PARAMETER;
+    }
+    auto *address = new uint8_t[size]();
+    *ashmem = new DDK_Ashmem{-1, address, size, 0, size, 0};
+    return DDK_SUCCESS;
+}
+
+DDK_RetCode OH_DDK_MapAshmem(DDK_Ashmem *ashmem, const uint8_t) { return ashmem ? DDK_SUCCESS : DDK_NULL_PTR; }
+
+DDK_RetCode OH_DDK_UnmapAshmem(DDK_Ashmem *ashmem) { return ashmem ? DDK_SUCCESS : DDK_NULL_PTR; }
+
+DDK_RetCode OH_DDK_DestroyAshmem(DDK_Ashmem *ashmem) {
+    if (!ashmem) {
+        return DDK_NULL_PTR;
+    }
+    delete[] ashmem->address;
+    delete ashmem;
+    return DDK_SUCCESS;
+}
+
+int32_t OH_Usb_Init(void) { return USB_DDK_SUCCESS; }
+
+void OH_Usb_Release(void) {}
+
+int32_t OH_Usb_ReleaseResource(void) { return USB_DDK_SUCCESS; }
+
+int32_t OH_Usb_GetDeviceDescriptor(uint64_t deviceId, UsbDeviceDescriptor *desc) {
+    if (deviceId != kDeviceId || !desc) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    *desc = UsbDeviceDescriptor{18, 1, 0x0200, 0, 0, 0, 64, 0x1234, 0x5678, 0x0100, 0, 0, 0, 1};
+    return USB_DDK_SUCCESS;
+}
+
+int32_t OH_Usb_GetConfigDescriptor(uint64_t deviceId, uint8_t configIndex,
+                                   struct UsbDdkConfigDescriptor **const config) {
+    if (deviceId != kDeviceId || configIndex != 0 || !config) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    *config = new UsbDdkConfigDescriptor{{9, 2, 32, 1, 1, 0, 0x80, 50}, &gInterface, nullptr, 0};
+    return USB_DDK_SUCCESS;
+}
+
+void OH_Usb_FreeConfigDescriptor(struct UsbDdkConfigDescriptor *const config) { delete config; }
+
+int32_t OH_Usb_ClaimInterface(uint64_t deviceId, uint8_t interfaceIndex, uint64_t *interfaceHandle) {
+    if (deviceId != kDeviceId || interfaceIndex != 0 || !interfaceHandle) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    *interfaceHandle = (deviceId << 8) | 1;
+    return USB_DDK_SUCCESS;
+}
+
+int32_t OH_Usb_ReleaseInterface(uint64_t interfaceHandle) {
+    return interfaceHandle ? USB_DDK_SUCCESS : USB_DDK_INVALID_PARAMETER;
+}
+
+int32_t OH_Usb_SelectInterfaceSetting(uint64_t interfaceHandle, uint8_t settingIndex) {
+    return interfaceHandle && settingIndex == 0 ? USB_DDK_SUCCESS : USB_DDK_INVALID_PARAMETER;
+}
+
+int32_t OH_Usb_GetCurrentInterfaceSetting(uint64_t interfaceHandle, uint8_t *settingIndex) {
+    if (!interfaceHandle || !settingIndex) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    *settingIndex = 0;
+    return USB_DDK_SUCCESS;
+}
+
+int32_t OH_Usb_SendControlReadRequest(uint64_t interfaceHandle, const struct UsbControlRequestSetup *setup,
+                                      uint32_t, uint8_t *data, uint32_t *dataLen) {
+    if (!interfaceHandle || !setup || !data || !dataLen) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    *dataLen = *dataLen < setup->wLength ? *dataLen : setup->wLength;
+    std::memset(data, 0, *dataLen);
+    return USB_DDK_SUCCESS;
+}
+
+int32_t OH_Usb_SendControlWriteRequest(uint64_t interfaceHandle, const struct UsbControlRequestSetup *setup,
+                                       uint32_t, const uint8_t *data, uint32_t dataLen) {
+    return interfaceHandle && setup && (data || dataLen == 0) ? USB_DDK_SUCCESS : USB_DDK_INVALID_PARAMETER;
+}
+
+int32_t OH_Usb_SendPipeRequest(const struct UsbRequestPipe *pipe, UsbDeviceMemMap *devMmap) {
+    if (!devMmap) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    return Transfer(pipe, devMmap->address + devMmap->offset, devMmap->bufferLength, &devMmap->transferedLength);
+}
+
+int32_t OH_Usb_SendPipeRequestWithAshmem(const struct UsbRequestPipe *pipe, DDK_Ashmem *ashmem) {
+    if (!ashmem) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    return Transfer(pipe, const_cast<uint8_t *>(ashmem->address) + ashmem->offset, ashmem->bufferLength,
+                    &ashmem->transferredLength);
+}
+
+int32_t OH_Usb_CreateDeviceMemMap(uint64_t deviceId, size_t size, UsbDeviceMemMap **devMmap) {
+    if (deviceId != kDeviceId || size == 0 || !devMmap) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    auto *address = new uint8_t[size]();
+    *devMmap = new UsbDeviceMemMap{address, size, 0, static_cast<uint32_t>(size), 0};
+    return USB_DDK_SUCCESS;
+}
+
+void OH_Usb_DestroyDeviceMemMap(UsbDeviceMemMap *devMmap) {
+    if (devMmap) {
+        delete[] devMmap->address;
+        delete devMmap;
+    }
+}
+
+int32_t OH_Usb_GetDevices(struct Usb_DeviceArray *devices) {
+    if (!devices || !devices->deviceIds) {
+        return USB_DDK_INVALID_PARAMETER;
+    }
+    devices->deviceIds[0] = kDeviceId;
+    devices->num = 1;
+    return USB_DDK_SUCCESS;
+}
+
+} // extern "C"
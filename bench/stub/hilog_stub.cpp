@@ -0,0 +1,100 @@
+// OH_LOG_Print 的 Linux 桩实现
+// 默认按 hilog 的方式展开格式串后 write 到 /dev/null，模拟一次格式化加一次系统调用的开销
+// 环境变量：
+//   HILOG_STUB_STDERR=1   输出到 stderr，便于调试
+//   HILOG_STUB_SYSCALL=0  只格式化，不做系统调用
+//   HILOG_STUB_LEVEL=n    OH_LOG_IsLoggable 只对不低于 n 的级别返回 true，默认 3（DEBUG）
+#include <hilog/log.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+struct StubConfig {
+    bool toStderr = false;
+    bool syscall = true;
+    int minLevel = LOG_DEBUG;
+    int nullFd = -1;
+
+    StubConfig() {
+        if (const char *env = std::getenv("HILOG_STUB_STDERR")) {
+            toStderr = std::atoi(env) != 0;
+        }
+        if (const char *env = std::getenv("HILOG_STUB_SYSCALL")) {
+            syscall = std::atoi(env) != 0;
+        }
+        if (const char *env = std::getenv("HILOG_STUB_LEVEL")) {
+            minLevel = std::atoi(env);
+        }
+        nullFd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    }
+
+    static StubConfig &Instance() {
+        static StubConfig instance;
+        return instance;
+    }
+};
+
+// 去掉 hilog 特有的 {public}/{private} 隐私标记，剩下的交给 vsnprintf
+void StripPrivacyFlags(const char *fmt, char *out, std::size_t size) {
+    std::size_t used = 0;
+    while (*fmt && used + 1 < size) {
+        if (fmt[0] == '%' && fmt[1] == '{') {
+            const char *close = std::strchr(fmt, '}');
+            if (close) {
+                out[used++] = '%';
+                fmt = close + 1;
+                continue;
+            }
+        }
+        out[used++] = *fmt++;
+    }
+    out[used] = '\0';
+}
+
+char LevelChar(LogLevel level) {
+    static const char names[] = "DIWEF";
+    return level >= LOG_DEBUG && level <= LOG_FATAL ? names[level - LOG_DEBUG] : '?';
+}
+
+} // namespace
+
+extern "C" int OH_LOG_Print(LogType type, LogLevel level, unsigned int domain, const char *tag, const char *fmt, ...) {
+    (void)type;
+    auto &config = StubConfig::Instance();
+    char format[256];
+    StripPrivacyFlags(fmt, format, sizeof(format));
+
+    // 和 hilog 一样单条上限 4096 字节
+    char line[4096];
+    int prefix = std::snprintf(line, sizeof(line), "%c %05X/%s: ", LevelChar(level), domain, tag);
+    va_list args;
+    va_start(args, fmt);
+    int body = std::vsnprintf(line + prefix, sizeof(line) - prefix, format, args);
+    va_end(args);
+    if (body < 0) {
+        return -1;
+    }
+    std::size_t len = prefix + body;
+    if (len >= sizeof(line)) {
+        len = sizeof(line) - 1;
+    }
+
+    if (config.toStderr) {
+        std::fprintf(stderr, "%s\n", line);
+    } else if (config.syscall && config.nullFd >= 0) {
+        (void)!::write(config.nullFd, line, len);
+    }
+    return static_cast<int>(len);
+}
+
+extern "C" bool OH_LOG_IsLoggable(unsigned int domain, const char *tag, LogLevel level) {
+    (void)domain;
+    (void)tag;
+    return level >= StubConfig::Instance().minLevel;
+}
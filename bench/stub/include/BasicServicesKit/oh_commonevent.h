@@ -0,0 +1,114 @@
+#ifndef COMMONEVENT_STUB_OH_COMMONEVENT_H
+#define COMMONEVENT_STUB_OH_COMMONEVENT_H
+
+// NDK BasicServicesKit/oh_commonevent.h 的桩，声明与 NDK 一致，供非 OHOS 工具链下编译 commev
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum CommonEvent_ErrCode {
+    COMMONEVENT_ERR_OK = 0,
+    COMMONEVENT_ERR_PERMISSION_ERROR = 201,
+    COMMONEVENT_ERR_NOT_SYSTEM_SERVICE = 202,
+    COMMONEVENT_ERR_INVALID_PARAMETER = 401,
+    COMMONEVENT_ERR_SENDING_REQUEST_FAILED = 1500007,
+    COMMONEVENT_ERR_INIT_UNDONE = 1500008,
+    COMMONEVENT_ERR_OBTAIN_SYSTEM_PARAMS = 1500009,
+    COMMONEVENT_ERR_SUBSCRIBER_NUM_EXCEEDED = 1500010,
+    COMMONEVENT_ERR_ALLOC_MEMORY_FAILED = 1500011,
+} CommonEvent_ErrCode;
+
+typedef struct CommonEvent_SubscribeInfo CommonEvent_SubscribeInfo;
+typedef void CommonEvent_Subscriber;
+typedef struct CommonEvent_RcvData CommonEvent_RcvData;
+typedef void CommonEvent_Parameters;
+typedef struct CommonEvent_PublishInfo CommonEvent_PublishInfo;
+typedef void (*CommonEvent_ReceiveCallback)(const CommonEvent_RcvData *data);
+
+CommonEvent_SubscribeInfo *OH_CommonEvent_CreateSubscribeInfo(const char *events[], int32_t eventsNum);
+CommonEvent_ErrCode OH_CommonEvent_SetPublisherPermission(CommonEvent_SubscribeInfo *info, const char *permission);
+CommonEvent_ErrCode OH_CommonEvent_SetPublisherBundleName(CommonEvent_SubscribeInfo *info, const char *bundleName);
+void OH_CommonEvent_DestroySubscribeInfo(CommonEvent_SubscribeInfo *info);
+
+CommonEvent_Subscriber *OH_CommonEvent_CreateSubscriber(const CommonEvent_SubscribeInfo *info,
+                                                        CommonEvent_ReceiveCallback callback);
+void OH_CommonEvent_DestroySubscriber(CommonEvent_Subscriber *subscriber);
+CommonEvent_ErrCode OH_CommonEvent_Subscribe(const CommonEvent_Subscriber *subscriber);
+CommonEvent_ErrCode OH_CommonEvent_UnSubscribe(const CommonEvent_Subscriber *subscriber);
+
+const char *OH_CommonEvent_GetEventFromRcvData(const CommonEvent_RcvData *rcvData);
+int32_t OH_CommonEvent_GetCodeFromRcvData(const CommonEvent_RcvData *rcvData);
+const char *OH_CommonEvent_GetDataStrFromRcvData(const CommonEvent_RcvData *rcvData);
+const char *OH_CommonEvent_GetBundleNameFromRcvData(const CommonEvent_RcvData *rcvData);
+const CommonEvent_Parameters *OH_CommonEvent_GetParametersFromRcvData(const CommonEvent_RcvData *rcvData);
+
+bool OH_CommonEvent_HasKeyInParameters(const CommonEvent_Parameters *para, const char *key);
+int OH_CommonEvent_GetIntFromParameters(const CommonEvent_Parameters *para, const char *key, const int defaultValue);
+int32_t OH_CommonEvent_GetIntArrayFromParameters(const CommonEvent_Parameters *para, const char *key, int **array);
+long OH_CommonEvent_GetLongFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                          const long defaultValue);
+int32_t OH_CommonEvent_GetLongArrayFromParameters(const CommonEvent_Parameters *para, const char *key, long **array);
+bool OH_CommonEvent_GetBoolFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                          const bool defaultValue);
+int32_t OH_CommonEvent_GetBoolArrayFromParameters(const CommonEvent_Parameters *para, const char *key, bool **array);
+char OH_CommonEvent_GetCharFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                          const char defaultValue);
+int32_t OH_CommonEvent_GetCharArrayFromParameters(const CommonEvent_Parameters *para, const char *key, char **array);
+double OH_CommonEvent_GetDoubleFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                              const double defaultValue);
+int32_t OH_CommonEvent_GetDoubleArrayFromParameters(const CommonEvent_Parameters *para, const char *key,
+                                                    double **array);
+
+// API 18
+CommonEvent_ErrCode OH_CommonEvent_Publish(const char *event);
+CommonEvent_ErrCode OH_CommonEvent_PublishWithInfo(const char *event, const CommonEvent_PublishInfo *info);
+
+CommonEvent_PublishInfo *OH_CommonEvent_CreatePublishInfo(bool ordered);
+void OH_CommonEvent_DestroyPublishInfo(CommonEvent_PublishInfo *info);
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoBundleName(CommonEvent_PublishInfo *info, const char *bundleName);
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoPermissions(CommonEvent_PublishInfo *info, const char *permissions[],
+                                                             int32_t num);
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoCode(CommonEvent_PublishInfo *info, int32_t code);
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoData(CommonEvent_PublishInfo *info, const char *data, size_t length);
+CommonEvent_ErrCode OH_CommonEvent_SetPublishInfoParameters(CommonEvent_PublishInfo *info,
+                                                            CommonEvent_Parameters *param);
+
+CommonEvent_Parameters *OH_CommonEvent_CreateParameters(void);
+void OH_CommonEvent_DestroyParameters(CommonEvent_Parameters *param);
+CommonEvent_ErrCode OH_CommonEvent_SetIntToParameters(CommonEvent_Parameters *param, const char *key, int value);
+CommonEvent_ErrCode OH_CommonEvent_SetIntArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                           const int *value, size_t num);
+CommonEvent_ErrCode OH_CommonEvent_SetLongToParameters(CommonEvent_Parameters *param, const char *key, long value);
+CommonEvent_ErrCode OH_CommonEvent_SetLongArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                            const long *value, size_t num);
+CommonEvent_ErrCode OH_CommonEvent_SetBoolToParameters(CommonEvent_Parameters *param, const char *key, bool value);
+CommonEvent_ErrCode OH_CommonEvent_SetBoolArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                            const bool *value, size_t num);
+CommonEvent_ErrCode OH_CommonEvent_SetCharToParameters(CommonEvent_Parameters *param, const char *key, char value);
+CommonEvent_ErrCode OH_CommonEvent_SetCharArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                            const char *value, size_t num);
+CommonEvent_ErrCode OH_CommonEvent_SetDoubleToParameters(CommonEvent_Parameters *param, const char *key,
+                                                         double value);
+CommonEvent_ErrCode OH_CommonEvent_SetDoubleArrayToParameters(CommonEvent_Parameters *param, const char *key,
+                                                              const double *value, size_t num);
+
+bool OH_CommonEvent_IsOrderedCommonEvent(const CommonEvent_Subscriber *subscriber);
+bool OH_CommonEvent_FinishCommonEvent(CommonEvent_Subscriber *subscriber);
+bool OH_CommonEvent_GetAbortCommonEvent(const CommonEvent_Subscriber *subscriber);
+bool OH_CommonEvent_AbortCommonEvent(CommonEvent_Subscriber *subscriber);
+bool OH_CommonEvent_ClearAbortCommonEvent(CommonEvent_Subscriber *subscriber);
+int32_t OH_CommonEvent_GetCodeFromSubscriber(const CommonEvent_Subscriber *subscriber);
+bool OH_CommonEvent_SetCodeToSubscriber(CommonEvent_Subscriber *subscriber, int32_t code);
+const char *OH_CommonEvent_GetDataFromSubscriber(const CommonEvent_Subscriber *subscriber);
+bool OH_CommonEvent_SetDataToSubscriber(CommonEvent_Subscriber *subscriber, const char *data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMONEVENT_STUB_OH_COMMONEVENT_H
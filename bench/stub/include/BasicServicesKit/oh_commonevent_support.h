@@ -0,0 +1,82 @@
+#ifndef COMMONEVENT_STUB_OH_COMMONEVENT_SUPPORT_H
+#define COMMONEVENT_STUB_OH_COMMONEVENT_SUPPORT_H
+
+// NDK BasicServicesKit/oh_commonevent_support.h 的桩，只收录了部分系统公共事件
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static const char *const COMMON_EVENT_SHUTDOWN = "usual.event.SHUTDOWN";
+static const char *const COMMON_EVENT_BATTERY_CHANGED = "usual.event.BATTERY_CHANGED";
+static const char *const COMMON_EVENT_BATTERY_LOW = "usual.event.BATTERY_LOW";
+static const char *const COMMON_EVENT_BATTERY_OKAY = "usual.event.BATTERY_OKAY";
+static const char *const COMMON_EVENT_POWER_CONNECTED = "usual.event.POWER_CONNECTED";
+static const char *const COMMON_EVENT_POWER_DISCONNECTED = "usual.event.POWER_DISCONNECTED";
+static const char *const COMMON_EVENT_SCREEN_OFF = "usual.event.SCREEN_OFF";
+static const char *const COMMON_EVENT_SCREEN_ON = "usual.event.SCREEN_ON";
+static const char *const COMMON_EVENT_THERMAL_LEVEL_CHANGED = "usual.event.THERMAL_LEVEL_CHANGED";
+static const char *const COMMON_EVENT_TIME_TICK = "usual.event.TIME_TICK";
+static const char *const COMMON_EVENT_TIME_CHANGED = "usual.event.TIME_CHANGED";
+static const char *const COMMON_EVENT_TIMEZONE_CHANGED = "usual.event.TIMEZONE_CHANGED";
+static const char *const COMMON_EVENT_PACKAGE_ADDED = "usual.event.PACKAGE_ADDED";
+static const char *const COMMON_EVENT_PACKAGE_REMOVED = "usual.event.PACKAGE_REMOVED";
+static const char *const COMMON_EVENT_PACKAGE_CHANGED = "usual.event.PACKAGE_CHANGED";
+static const char *const COMMON_EVENT_PACKAGE_RESTARTED = "usual.event.PACKAGE_RESTARTED";
+static const char *const COMMON_EVENT_PACKAGE_DATA_CLEARED = "usual.event.PACKAGE_DATA_CLEARED";
+static const char *const COMMON_EVENT_PACKAGE_CACHE_CLEARED = "usual.event.PACKAGE_CACHE_CLEARED";
+static const char *const COMMON_EVENT_CONFIGURATION_CHANGED = "usual.event.CONFIGURATION_CHANGED";
+static const char *const COMMON_EVENT_MANAGE_PACKAGE_STORAGE = "usual.event.MANAGE_PACKAGE_STORAGE";
+static const char *const COMMON_EVENT_DRIVE_MODE = "common.event.DRIVE_MODE";
+static const char *const COMMON_EVENT_HOME_MODE = "common.event.HOME_MODE";
+static const char *const COMMON_EVENT_OFFICE_MODE = "common.event.OFFICE_MODE";
+static const char *const COMMON_EVENT_USER_STARTED = "usual.event.USER_STARTED";
+static const char *const COMMON_EVENT_USER_BACKGROUND = "usual.event.USER_BACKGROUND";
+static const char *const COMMON_EVENT_USER_FOREGROUND = "usual.event.USER_FOREGROUND";
+static const char *const COMMON_EVENT_USER_SWITCHED = "usual.event.USER_SWITCHED";
+static const char *const COMMON_EVENT_USER_STARTING = "usual.event.USER_STARTING";
+static const char *const COMMON_EVENT_USER_UNLOCKED = "usual.event.USER_UNLOCKED";
+static const char *const COMMON_EVENT_USER_STOPPING = "usual.event.USER_STOPPING";
+static const char *const COMMON_EVENT_USER_STOPPED = "usual.event.USER_STOPPED";
+static const char *const COMMON_EVENT_WIFI_POWER_STATE = "usual.event.wifi.POWER_STATE";
+static const char *const COMMON_EVENT_WIFI_SCAN_FINISHED = "usual.event.wifi.SCAN_FINISHED";
+static const char *const COMMON_EVENT_WIFI_RSSI_VALUE = "usual.event.wifi.RSSI_VALUE";
+static const char *const COMMON_EVENT_WIFI_CONN_STATE = "usual.event.wifi.CONN_STATE";
+static const char *const COMMON_EVENT_WIFI_HOTSPOT_STATE = "usual.event.wifi.HOTSPOT_STATE";
+static const char *const COMMON_EVENT_WIFI_AP_STA_JOIN = "usual.event.wifi.WIFI_HS_STA_JOIN";
+static const char *const COMMON_EVENT_WIFI_AP_STA_LEAVE = "usual.event.wifi.WIFI_HS_STA_LEAVE";
+static const char *const COMMON_EVENT_WIFI_MPLINK_STATE_CHANGE = "usual.event.wifi.mplink.STATE_CHANGE";
+static const char *const COMMON_EVENT_WIFI_P2P_CONN_STATE = "usual.event.wifi.p2p.CONN_STATE_CHANGE";
+static const char *const COMMON_EVENT_WIFI_P2P_STATE_CHANGED = "usual.event.wifi.p2p.STATE_CHANGE";
+static const char *const COMMON_EVENT_WIFI_P2P_PEERS_STATE_CHANGED = "usual.event.wifi.p2p.DEVICES_CHANGE";
+static const char *const COMMON_EVENT_WIFI_P2P_PEERS_DISCOVERY_STATE_CHANGED =
+    "usual.event.wifi.p2p.PEER_DISCOVERY_STATE_CHANGE";
+static const char *const COMMON_EVENT_WIFI_P2P_CURRENT_DEVICE_STATE_CHANGED =
+    "usual.event.wifi.p2p.CURRENT_DEVICE_CHANGE";
+static const char *const COMMON_EVENT_WIFI_P2P_GROUP_STATE_CHANGED = "usual.event.wifi.p2p.GROUP_STATE_CHANGED";
+static const char *const COMMON_EVENT_USB_STATE = "usual.event.hardware.usb.action.USB_STATE";
+static const char *const COMMON_EVENT_USB_PORT_CHANGED = "usual.event.hardware.usb.action.USB_PORT_CHANGED";
+static const char *const COMMON_EVENT_USB_DEVICE_ATTACHED = "usual.event.hardware.usb.action.USB_DEVICE_ATTACHED";
+static const char *const COMMON_EVENT_USB_DEVICE_DETACHED = "usual.event.hardware.usb.action.USB_DEVICE_DETACHED";
+static const char *const COMMON_EVENT_DISK_REMOVED = "usual.event.data.DISK_REMOVED";
+static const char *const COMMON_EVENT_DISK_UNMOUNTED = "usual.event.data.DISK_UNMOUNTED";
+static const char *const COMMON_EVENT_DISK_MOUNTED = "usual.event.data.DISK_MOUNTED";
+static const char *const COMMON_EVENT_DISK_BAD_REMOVAL = "usual.event.data.DISK_BAD_REMOVAL";
+static const char *const COMMON_EVENT_DISK_UNMOUNTABLE = "usual.event.data.DISK_UNMOUNTABLE";
+static const char *const COMMON_EVENT_DISK_EJECT = "usual.event.data.DISK_EJECT";
+static const char *const COMMON_EVENT_VOLUME_REMOVED = "usual.event.data.VOLUME_REMOVED";
+static const char *const COMMON_EVENT_VOLUME_UNMOUNTED = "usual.event.data.VOLUME_UNMOUNTED";
+static const char *const COMMON_EVENT_VOLUME_MOUNTED = "usual.event.data.VOLUME_MOUNTED";
+static const char *const COMMON_EVENT_VOLUME_BAD_REMOVAL = "usual.event.data.VOLUME_BAD_REMOVAL";
+static const char *const COMMON_EVENT_VOLUME_EJECT = "usual.event.data.VOLUME_EJECT";
+static const char *const COMMON_EVENT_AIRPLANE_MODE_CHANGED = "usual.event.AIRPLANE_MODE";
+static const char *const COMMON_EVENT_SCREEN_LOCKED = "usual.event.SCREEN_LOCKED";
+static const char *const COMMON_EVENT_SCREEN_UNLOCKED = "usual.event.SCREEN_UNLOCKED";
+static const char *const COMMON_EVENT_CHARGING = "usual.event.CHARGING";
+static const char *const COMMON_EVENT_DISCHARGING = "usual.event.DISCHARGING";
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMONEVENT_STUB_OH_COMMONEVENT_SUPPORT_H
@@ -0,0 +1,23 @@
+#ifndef COMMONEVENT_STUB_CONTROL_H
+#define COMMONEVENT_STUB_CONTROL_H
+
+// libohcommonevent 桩实现特有的控制接口，NDK 中没有，只供主机上的基准测试使用
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 发布到订阅者收到之间注入的延迟，模拟两次 IPC；有序事件每传给下一个订阅者都再延迟一次
+void CommonEventStub_SetLatency(uint32_t microseconds);
+// 有序事件的订阅者迟迟不调用 OH_CommonEvent_FinishCommonEvent 时，超时后自动传给下一个订阅者
+void CommonEventStub_SetOrderedTimeout(uint32_t milliseconds);
+// 等待已发布的事件全部投递完
+void CommonEventStub_Flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMONEVENT_STUB_CONTROL_H
@@ -0,0 +1,21 @@
+#ifndef DDK_STUB_DDK_API_H
+#define DDK_STUB_DDK_API_H
+
+// NDK ddk/ddk_api.h 的桩，声明与 NDK 一致，供非 OHOS 工具链下编译 device
+
+#include "ddk_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+DDK_RetCode OH_DDK_CreateAshmem(const uint8_t *name, uint32_t size, DDK_Ashmem **ashmem);
+DDK_RetCode OH_DDK_MapAshmem(DDK_Ashmem *ashmem, const uint8_t ashmemMapType);
+DDK_RetCode OH_DDK_UnmapAshmem(DDK_Ashmem *ashmem);
+DDK_RetCode OH_DDK_DestroyAshmem(DDK_Ashmem *ashmem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DDK_STUB_DDK_API_H
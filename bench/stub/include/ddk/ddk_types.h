@@ -0,0 +1,33 @@
+#ifndef DDK_STUB_DDK_TYPES_H
+#define DDK_STUB_DDK_TYPES_H
+
+// NDK ddk/ddk_types.h 的桩，声明与 NDK 一致，供非 OHOS 工具链下编译 device
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct DDK_Ashmem {
+    int32_t ashmemFd;
+    const uint8_t *address;
+    const uint32_t size;
+    uint32_t offset;
+    uint32_t bufferLength;
+    uint32_t transferredLength;
+} DDK_Ashmem;
+
+typedef enum {
+    DDK_SUCCESS = 0,
+    DDK_FAILURE = 28600001,
+    DDK_INVALID_PARAMETER = 28600002,
+    DDK_INVALID_OPERATION = 28600003,
+    DDK_NULL_PTR = 28600004,
+} DDK_RetCode;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DDK_STUB_DDK_TYPES_H
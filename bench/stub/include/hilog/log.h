@@ -0,0 +1,32 @@
+#ifndef HILOG_STUB_LOG_H
+#define HILOG_STUB_LOG_H
+
+// NDK hilog/log.h 的桩，只声明 hilogpp 用到的部分，供非 OHOS 工具链下编译和跑基准测试
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LOG_APP = 0,
+} LogType;
+
+typedef enum {
+    LOG_DEBUG = 3,
+    LOG_INFO = 4,
+    LOG_WARN = 5,
+    LOG_ERROR = 6,
+    LOG_FATAL = 7,
+} LogLevel;
+
+int OH_LOG_Print(LogType type, LogLevel level, unsigned int domain, const char *tag, const char *fmt, ...);
+
+bool OH_LOG_IsLoggable(unsigned int domain, const char *tag, LogLevel level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HILOG_STUB_LOG_H
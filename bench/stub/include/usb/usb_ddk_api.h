@@ -0,0 +1,39 @@
+#ifndef DDK_STUB_USB_DDK_API_H
+#define DDK_STUB_USB_DDK_API_H
+
+// NDK usb/usb_ddk_api.h 的桩，声明与 NDK 一致，供非 OHOS 工具链下编译 device
+
+#include <ddk/ddk_types.h>
+
+#include "usb_ddk_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int32_t OH_Usb_Init(void);
+void OH_Usb_Release(void);
+int32_t OH_Usb_ReleaseResource(void);
+int32_t OH_Usb_GetDeviceDescriptor(uint64_t deviceId, UsbDeviceDescriptor *desc);
+int32_t OH_Usb_GetConfigDescriptor(uint64_t deviceId, uint8_t configIndex,
+                                   struct UsbDdkConfigDescriptor **const config);
+void OH_Usb_FreeConfigDescriptor(struct UsbDdkConfigDescriptor *const config);
+int32_t OH_Usb_ClaimInterface(uint64_t deviceId, uint8_t interfaceIndex, uint64_t *interfaceHandle);
+int32_t OH_Usb_ReleaseInterface(uint64_t interfaceHandle);
+int32_t OH_Usb_SelectInterfaceSetting(uint64_t interfaceHandle, uint8_t settingIndex);
+int32_t OH_Usb_GetCurrentInterfaceSetting(uint64_t interfaceHandle, uint8_t *settingIndex);
+int32_t OH_Usb_SendControlReadRequest(uint64_t interfaceHandle, const struct UsbControlRequestSetup *setup,
+                                      uint32_t timeout, uint8_t *data, uint32_t *dataLen);
+int32_t OH_Usb_SendControlWriteRequest(uint64_t interfaceHandle, const struct UsbControlRequestSetup *setup,
+                                       uint32_t timeout, const uint8_t *data, uint32_t dataLen);
+int32_t OH_Usb_SendPipeRequest(const struct UsbRequestPipe *pipe, UsbDeviceMemMap *devMmap);
+int32_t OH_Usb_SendPipeRequestWithAshmem(const struct UsbRequestPipe *pipe, DDK_Ashmem *ashmem);
+int32_t OH_Usb_CreateDeviceMemMap(uint64_t deviceId, size_t size, UsbDeviceMemMap **devMmap);
+void OH_Usb_DestroyDeviceMemMap(UsbDeviceMemMap *devMmap);
+int32_t OH_Usb_GetDevices(struct Usb_DeviceArray *devices);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DDK_STUB_USB_DDK_API_H
@@ -0,0 +1,130 @@
+#ifndef DDK_STUB_USB_DDK_TYPES_H
+#define DDK_STUB_USB_DDK_TYPES_H
+
+// NDK usb/usb_ddk_types.h 的桩，声明与 NDK 一致，供非 OHOS 工具链下编译 device
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct UsbControlRequestSetup {
+    uint8_t bmRequestType;
+    uint8_t bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} __attribute__((aligned(8))) UsbControlRequestSetup;
+
+typedef struct UsbDeviceDescriptor {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint16_t bcdUSB;
+    uint8_t bDeviceClass;
+    uint8_t bDeviceSubClass;
+    uint8_t bDeviceProtocol;
+    uint8_t bMaxPacketSize0;
+    uint16_t idVendor;
+    uint16_t idProduct;
+    uint16_t bcdDevice;
+    uint8_t iManufacturer;
+    uint8_t iProduct;
+    uint8_t iSerialNumber;
+    uint8_t bNumConfigurations;
+} __attribute__((aligned(8))) UsbDeviceDescriptor;
+
+typedef struct UsbConfigDescriptor {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint16_t wTotalLength;
+    uint8_t bNumInterfaces;
+    uint8_t bConfigurationValue;
+    uint8_t iConfiguration;
+    uint8_t bmAttributes;
+    uint8_t bMaxPower;
+} __attribute__((aligned(8))) UsbConfigDescriptor;
+
+typedef struct UsbInterfaceDescriptor {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bInterfaceNumber;
+    uint8_t bAlternateSetting;
+    uint8_t bNumEndpoints;
+    uint8_t bInterfaceClass;
+    uint8_t bInterfaceSubClass;
+    uint8_t bInterfaceProtocol;
+    uint8_t iInterface;
+} __attribute__((aligned(8))) UsbInterfaceDescriptor;
+
+typedef struct UsbEndpointDescriptor {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bEndpointAddress;
+    uint8_t bmAttributes;
+    uint16_t wMaxPacketSize;
+    uint8_t bInterval;
+    uint8_t bRefresh;
+    uint8_t bSynchAddress;
+} __attribute__((aligned(8))) UsbEndpointDescriptor;
+
+typedef struct UsbDdkEndpointDescriptor {
+    UsbEndpointDescriptor endpointDescriptor;
+    const uint8_t *extra;
+    uint32_t extraLength;
+} UsbDdkEndpointDescriptor;
+
+typedef struct UsbDdkInterfaceDescriptor {
+    UsbInterfaceDescriptor interfaceDescriptor;
+    UsbDdkEndpointDescriptor *endPoint;
+    const uint8_t *extra;
+    uint32_t extraLength;
+} UsbDdkInterfaceDescriptor;
+
+typedef struct UsbDdkInterface {
+    uint8_t numAltsetting;
+    UsbDdkInterfaceDescriptor *altsetting;
+} UsbDdkInterface;
+
+typedef struct UsbDdkConfigDescriptor {
+    UsbConfigDescriptor configDescriptor;
+    UsbDdkInterface *interface;
+    const uint8_t *extra;
+    uint32_t extraLength;
+} UsbDdkConfigDescriptor;
+
+typedef struct UsbRequestPipe {
+    uint64_t interfaceHandle;
+    uint32_t timeout;
+    uint8_t endpoint;
+} __attribute__((aligned(8))) UsbRequestPipe;
+
+typedef struct UsbDeviceMemMap {
+    uint8_t *const address;
+    const size_t size;
+    uint32_t offset;
+    uint32_t bufferLength;
+    uint32_t transferedLength;
+} UsbDeviceMemMap;
+
+typedef struct Usb_DeviceArray {
+    uint64_t *deviceIds;
+    uint32_t num;
+} Usb_DeviceArray;
+
+typedef enum {
+    USB_DDK_SUCCESS = 0,
+    USB_DDK_NO_PERM = 201,
+    USB_DDK_INVALID_PARAMETER = 401,
+    USB_DDK_MEMORY_ERROR = 27400001,
+    USB_DDK_INVALID_OPERATION = 27400002,
+    USB_DDK_IO_FAILED = 27400003,
+    USB_DDK_TIMEOUT = 27400004,
+} UsbDdkErrCode;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DDK_STUB_USB_DDK_TYPES_H
@@ -0,0 +1,21 @@
+#ifndef USB_DDK_STUB_CONTROL_H
+#define USB_DDK_STUB_CONTROL_H
+
+// libusb_ndk 桩实现特有的控制接口，NDK 中没有，只供主机上的基准测试使用
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 每个管道请求的往返延迟，各请求之间可以重叠
+void UsbDdkStub_SetLatency(uint32_t microseconds);
+// 总线带宽，数据部分在总线上串行传输；0 表示不限
+void UsbDdkStub_SetBandwidth(uint32_t bytesPerMicrosecond);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // USB_DDK_STUB_CONTROL_H
@@ -0,0 +1,271 @@
+#ifndef COMMONEV_ASYNC_H
+#define COMMONEV_ASYNC_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "event.h"
+#include "record.h"
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+// 队列满时的处理策略
+enum class Backpressure {
+    DropNewest, // 丢弃刚收到的事件
+    DropOldest, // 丢弃队列中最老的一条事件为新事件腾出位置，腾不出时丢弃新事件
+    Block,      // 阻塞 CES 的回调线程直到队列有空位
+};
+
+struct AsyncOptions {
+    std::size_t capacity = 256; // 队列槽位数，向上取整为2的幂，每个槽位预先分配一个 EventRecord
+    std::size_t workers = 1;    // 执行处理函数的线程数，大于1时同一事件的处理顺序不再保证
+    Backpressure policy = Backpressure::DropNewest;
+    std::vector<ParamKey> parameters; // 需要随事件一起拷贝的参数
+};
+
+struct AsyncMetrics {
+    std::size_t depth = 0;       // 当前排队的事件数
+    std::size_t maxDepth = 0;    // 排队数的历史最大值
+    std::uint64_t enqueued = 0;  // 进入队列的事件数
+    std::uint64_t processed = 0; // 处理完的事件数
+    std::uint64_t dropped = 0;   // 因队列满被丢弃的事件数
+    std::uint64_t blocked = 0;   // Block 策略下回调线程等待空位的次数
+};
+
+/**
+ * @brief 把收到的事件拷贝进预先分配的记录，放进有界无锁队列，由工作线程执行处理函数
+ * @note 工作线程出队时把槽位里的记录与自己的记录交换后立即让出槽位，再执行处理函数，
+ *       分配过的缓冲区在槽位和工作线程间轮转；析构时先处理完队列中剩余的事件
+ */
+class AsyncDispatcher {
+public:
+    using Handler = std::function<void(const EventRecord &)>;
+
+    AsyncDispatcher(Handler handler, AsyncOptions options = AsyncOptions())
+        : handler_(std::move(handler)), options_(std::move(options)) {
+        std::size_t capacity = 2;
+        while (capacity < options_.capacity) {
+            capacity <<= 1;
+        }
+        options_.capacity = capacity;
+        mask_ = capacity - 1;
+        slots_.reset(new Slot[capacity]);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+        const std::size_t workers = options_.workers > 0 ? options_.workers : 1;
+        for (std::size_t i = 0; i < workers; ++i) {
+            workers_.emplace_back(&AsyncDispatcher::run, this);
+        }
+    }
+
+    ~AsyncDispatcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_.store(true);
+        }
+        wakeup_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    AsyncDispatcher(const AsyncDispatcher &) = delete;
+    AsyncDispatcher &operator=(const AsyncDispatcher &) = delete;
+
+    // 在 CES 的回调线程上调用，只做拷贝和入队
+    void post(const RcvData &data) {
+        bool pushed = false;
+        switch (options_.policy) {
+        case Backpressure::DropNewest:
+            pushed = tryPush(data);
+            break;
+        case Backpressure::DropOldest:
+            // 每次最多挤掉一条；队首的槽位恰好正被工作线程交换出去时腾不出位置，改为丢弃新事件，不在这里等待
+            pushed = tryPush(data);
+            if (!pushed && tryPop(nullptr)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                pushed = tryPush(data);
+            }
+            break;
+        case Backpressure::Block:
+            for (unsigned spins = 0; !(pushed = tryPush(data)); ++spins) {
+                if (spins == 0) {
+                    blocked_.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (spins < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+            break;
+        }
+        if (!pushed) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // 与工作线程登记 idle_ 后的再检查构成 Dekker 式配对，保证不会漏掉唤醒
+        if (idle_.load() > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wakeup_.notify_one();
+        }
+    }
+
+    void operator()(const RcvData &data) { post(data); }
+
+    AsyncMetrics metrics() const {
+        AsyncMetrics metrics;
+        const std::size_t enqueued = enqueuePos_.load(std::memory_order_relaxed);
+        const std::size_t dequeued = dequeuePos_.load(std::memory_order_relaxed);
+        metrics.depth = enqueued > dequeued ? enqueued - dequeued : 0;
+        metrics.maxDepth = maxDepth_.load(std::memory_order_relaxed);
+        metrics.enqueued = enqueued;
+        metrics.processed = processed_.load(std::memory_order_relaxed);
+        metrics.dropped = dropped_.load(std::memory_order_relaxed);
+        metrics.blocked = blocked_.load(std::memory_order_relaxed);
+        return metrics;
+    }
+
+    const AsyncOptions &options() const { return options_; }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        EventRecord record;
+    };
+
+    bool tryPush(const RcvData &data) {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->record.assign(data, options_.parameters);
+        slot->seq.store(pos + 1, std::memory_order_release);
+
+        // 读到的出队位置可能已经越过刚入队的这条
+        const std::size_t dequeued = dequeuePos_.load(std::memory_order_relaxed);
+        const std::size_t depth = pos + 1 > dequeued ? pos + 1 - dequeued : 0;
+        std::size_t maxDepth = maxDepth_.load(std::memory_order_relaxed);
+        while (depth > maxDepth && !maxDepth_.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed)) {
+        }
+        return true;
+    }
+
+    // 出队一条，与 out 交换记录后让出槽位；out 为空时只出队丢弃。DropOldest 策略下回调线程也会调用，所以按多消费者处理
+    bool tryPop(EventRecord *out) {
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        if (out) {
+            std::swap(*out, slot->record);
+        }
+        slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    void run() {
+        EventRecord record;
+        for (;;) {
+            while (tryPop(&record)) {
+                handler_(record);
+                processed_.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            idle_.fetch_add(1);
+            // 登记 idle_ 之后再看一眼队列，避免和回调线程错过彼此
+            const bool empty = enqueuePos_.load() == dequeuePos_.load();
+            if (empty) {
+                if (stopping_.load()) {
+                    idle_.fetch_sub(1);
+                    return;
+                }
+                wakeup_.wait_for(lock, std::chrono::milliseconds(100));
+            }
+            idle_.fetch_sub(1);
+        }
+    }
+
+    Handler handler_;
+    AsyncOptions options_;
+    std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::atomic<std::size_t> dequeuePos_{0};
+    alignas(64) std::atomic<std::uint64_t> processed_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> blocked_{0};
+    std::atomic<std::size_t> maxDepth_{0};
+
+    std::atomic<std::size_t> idle_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief 异步模式的订阅者：CES 的回调线程只负责拷贝入队，处理函数在工作线程上执行
+ * @note 析构时先销毁原生订阅者，再处理完队列中剩余的事件
+ */
+class AsyncSubscriber {
+public:
+    AsyncSubscriber(const SubscribeInfo *info, AsyncDispatcher::Handler handler, AsyncOptions options = AsyncOptions())
+        : dispatcher_(new AsyncDispatcher(std::move(handler), std::move(options))),
+          subscriber_(info, [dispatcher = dispatcher_.get()](const RcvData &data) { dispatcher->post(data); }) {}
+
+    void subscribe() const { subscriber_.subscribe(); }
+    void unSubscribe() const { subscriber_.unSubscribe(); }
+
+    AsyncMetrics metrics() const { return dispatcher_->metrics(); }
+
+    const Subscriber &subscriber() const { return subscriber_; }
+
+private:
+    std::unique_ptr<AsyncDispatcher> dispatcher_; // 比 subscriber_ 晚析构
+    Subscriber subscriber_;
+};
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_ASYNC_H
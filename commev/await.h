@@ -0,0 +1,382 @@
+#ifndef COMMONEV_AWAIT_H
+#define COMMONEV_AWAIT_H
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+# error "await.h requires C++20 coroutines"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bus.h"
+#include "record.h"
+
+/**
+ * 用协程等待事件，代替回调加条件变量：
+ *
+ *   Detached watch(AwaitSubscriber &subscriber, QueueExecutor &executor) {
+ *       auto record = co_await NextEvent(subscriber, COMMON_EVENT_USB_DEVICE_ATTACHED, 5s, executor);
+ *       if (!record) { ... 超时 ... }
+ *   }
+ *
+ * 等待中的协程不占线程，只占一个等待记录；同一 AwaitSubscriber 上的全部等待者共用 EventBus 上每个事件一个监听，
+ * 超时由一个计时线程统一处理。收到事件或超时后，协程通过调用者指定的 executor 恢复。
+ * 不要把 co_await 写在 if/while 的条件里，包括 if (co_await ...)、if ((co_await ...).has_value())、
+ * while (!(co_await ...)) 等形式：GCC 12.2 为这类条件生成的协程帧有误，恢复时崩溃，与等待者的实现无关
+ * （await_suspend 只保存句柄、await_resume 只返回 bool 的空等待者同样复现）。一律先存到变量再判断。
+ * AwaitedEvent 的成员只能在具名变量上使用，能挡住直接在条件里访问结果的写法，其他形式编译器发现不了
+ */
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+// 在收到事件的 CES 回调线程（超时时为计时线程）上直接恢复协程
+struct InlineExecutor {
+    template <typename Fn> void post(Fn &&fn) { fn(); }
+};
+
+/**
+ * @brief 排队等待执行的任务，由调用 poll/wait 的线程恢复协程
+ * @note 用于接入已有的事件循环，或者让全部协程都在同一个线程上运行
+ */
+class QueueExecutor {
+public:
+    void post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        ready_.notify_one();
+    }
+
+    // 执行当前排队的全部任务，返回执行的个数
+    std::size_t poll() {
+        std::deque<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks.swap(tasks_);
+        }
+        for (auto &task : tasks) {
+            task();
+        }
+        return tasks.size();
+    }
+
+    // 最多等待 timeout 直到有任务，再执行全部排队的任务
+    template <typename Rep, typename Period> std::size_t wait(std::chrono::duration<Rep, Period> timeout) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait_for(lock, timeout, [this] { return !tasks_.empty(); });
+        }
+        return poll();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> tasks_;
+};
+
+// 启动后不等待结果的协程返回类型，协程里没有捕获的异常直接终止进程
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/**
+ * @brief co_await NextEvent 的结果，收到的事件或为空
+ * @note 右值上的成员全部删除，结果要先绑定到变量才能访问，见文件开头关于 if/while 条件的说明
+ */
+class AwaitedEvent {
+public:
+    AwaitedEvent() = default;
+    explicit AwaitedEvent(std::optional<EventRecord> &&record) : record_(std::move(record)) {}
+
+    bool has_value() const & noexcept { return record_.has_value(); }
+    explicit operator bool() const & noexcept { return record_.has_value(); }
+    EventRecord &operator*() & { return *record_; }
+    const EventRecord &operator*() const & { return *record_; }
+    EventRecord *operator->() & { return &*record_; }
+    const EventRecord *operator->() const & { return &*record_; }
+    // 把结果转交出去，之后本对象为空
+    std::optional<EventRecord> release() & { return std::exchange(record_, std::nullopt); }
+
+    bool has_value() const && = delete;
+    explicit operator bool() const && = delete;
+    const EventRecord &operator*() const && = delete;
+    const EventRecord *operator->() const && = delete;
+    std::optional<EventRecord> release() && = delete;
+
+private:
+    std::optional<EventRecord> record_;
+};
+
+namespace detail {
+
+// 一次等待，收到事件、超时或取消三者只有一个能把 done 置位并负责恢复协程
+struct AwaitWaiter {
+    std::string event;
+    std::vector<ParamKey> keys;
+    std::atomic<bool> done{false};
+    std::optional<EventRecord> result;
+    std::coroutine_handle<> handle;
+    void *executor = nullptr;
+    void (*post)(void *executor, std::coroutine_handle<> handle) = nullptr;
+
+    void resume() { post(executor, handle); }
+};
+
+// 监听回调可能在 AwaitSubscriber 析构后才返回，共享的状态单独放在这里
+class AwaitCore {
+public:
+    using Clock = std::chrono::steady_clock;
+    using WaiterPtr = std::shared_ptr<AwaitWaiter>;
+
+    void dispatch(const RcvData &data) {
+        const char *event = data.event();
+        if (!event) {
+            return;
+        }
+        std::vector<WaiterPtr> waiters;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = waiters_.find(event);
+            if (it == waiters_.end()) {
+                return;
+            }
+            waiters.swap(it->second);
+        }
+        for (const auto &waiter : waiters) {
+            if (!waiter->done.exchange(true)) {
+                waiter->result.emplace().assign(data, waiter->keys);
+                waiter->resume();
+            }
+        }
+    }
+
+    void add(const WaiterPtr &waiter, std::optional<Clock::time_point> deadline) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        waiters_[waiter->event].push_back(waiter);
+        if (deadline) {
+            timers_.emplace(*deadline, waiter);
+            if (!timer_.joinable()) {
+                timer_ = std::thread(&AwaitCore::runTimer, this);
+            }
+            timerWakeup_.notify_one();
+        }
+    }
+
+    // 以 nullopt 恢复全部还在等待的协程，停止计时线程
+    void cancel() {
+        std::vector<WaiterPtr> waiters;
+        std::thread timer;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &item : waiters_) {
+                waiters.insert(waiters.end(), item.second.begin(), item.second.end());
+            }
+            waiters_.clear();
+            timers_ = {};
+            stopping_ = true;
+            timer.swap(timer_);
+        }
+        timerWakeup_.notify_one();
+        if (timer.joinable()) {
+            timer.join();
+        }
+        for (const auto &waiter : waiters) {
+            if (!waiter->done.exchange(true)) {
+                waiter->resume();
+            }
+        }
+    }
+
+    std::size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t count = 0;
+        for (const auto &item : waiters_) {
+            count += item.second.size();
+        }
+        return count;
+    }
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        WaiterPtr waiter;
+        bool operator>(const Timer &other) const { return deadline > other.deadline; }
+    };
+
+    // 提前收到事件的等待者不从堆中删除，到期时发现已经完成直接丢弃
+    void runTimer() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            if (timers_.empty()) {
+                timerWakeup_.wait(lock);
+                continue;
+            }
+            const Clock::time_point deadline = timers_.top().deadline;
+            if (Clock::now() < deadline) {
+                timerWakeup_.wait_until(lock, deadline);
+                continue;
+            }
+            WaiterPtr waiter = timers_.top().waiter;
+            timers_.pop();
+            if (waiter->done.exchange(true)) {
+                continue;
+            }
+            auto it = waiters_.find(waiter->event);
+            if (it != waiters_.end()) {
+                auto &list = it->second;
+                list.erase(std::remove(list.begin(), list.end(), waiter), list.end());
+            }
+            lock.unlock();
+            waiter->resume();
+            lock.lock();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<WaiterPtr>> waiters_; // 按事件名
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    std::condition_variable timerWakeup_;
+    std::thread timer_; // 第一次带超时的等待时才启动
+    bool stopping_ = false;
+};
+
+} // namespace detail
+
+/**
+ * @brief 可以 co_await 的订阅者，配合 NextEvent 使用
+ * @note 第一次等待某个事件时在 EventBus 上监听它，之后一直保留；
+ *       析构时还在等待的协程以 nullopt 恢复，恢复后不能再使用该对象
+ */
+class AwaitSubscriber {
+public:
+    explicit AwaitSubscriber(EventBus &bus = EventBus::Instance())
+        : bus_(bus), core_(std::make_shared<detail::AwaitCore>()) {}
+
+    AwaitSubscriber(const AwaitSubscriber &) = delete;
+    AwaitSubscriber &operator=(const AwaitSubscriber &) = delete;
+
+    ~AwaitSubscriber() {
+        {
+            std::lock_guard<std::mutex> lock(listenMutex_);
+            subscriptions_.clear();
+        }
+        core_->cancel();
+    }
+
+    // 还在等待的协程数
+    std::size_t pending() const { return core_->pending(); }
+
+    // 供 NextEvent 使用：确保已在监听事件，再登记等待者；监听失败时抛出 std::system_error
+    void wait(const std::shared_ptr<detail::AwaitWaiter> &waiter,
+              std::optional<detail::AwaitCore::Clock::time_point> deadline) {
+        {
+            std::lock_guard<std::mutex> lock(listenMutex_);
+            if (subscriptions_.find(waiter->event) == subscriptions_.end()) {
+                std::weak_ptr<detail::AwaitCore> core = core_;
+                subscriptions_.emplace(waiter->event, bus_.listen(waiter->event.c_str(), [core](const RcvData &data) {
+                    if (auto locked = core.lock()) {
+                        locked->dispatch(data);
+                    }
+                }));
+            }
+        }
+        core_->add(waiter, deadline);
+    }
+
+private:
+    EventBus &bus_;
+    std::shared_ptr<detail::AwaitCore> core_;
+    std::mutex listenMutex_;
+    std::map<std::string, EventBus::Subscription> subscriptions_;
+};
+
+/**
+ * @brief co_await 的结果为收到的事件，超时或订阅者析构时为空，见 AwaitedEvent
+ * @note 只会收到挂起之后才到达的事件；需要随事件拷贝的参数由 keys 列出
+ */
+template <typename Executor> class NextEventAwaiter {
+public:
+    using Clock = detail::AwaitCore::Clock;
+
+    NextEventAwaiter(AwaitSubscriber &subscriber, const char *event, std::optional<Clock::duration> timeout,
+                     Executor &executor, std::vector<ParamKey> keys)
+        : subscriber_(subscriber), timeout_(timeout), waiter_(std::make_shared<detail::AwaitWaiter>()) {
+        waiter_->event = event;
+        waiter_->keys = std::move(keys);
+        waiter_->executor = &executor;
+        waiter_->post = [](void *target, std::coroutine_handle<> handle) {
+            static_cast<Executor *>(target)->post([handle] { handle.resume(); });
+        };
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    // 登记之后协程可能立刻在别的线程上恢复，不能再访问自身
+    void await_suspend(std::coroutine_handle<> handle) {
+        waiter_->handle = handle;
+        std::optional<Clock::time_point> deadline;
+        if (timeout_) {
+            deadline = Clock::now() + *timeout_;
+        }
+        auto waiter = waiter_;
+        subscriber_.wait(waiter, deadline);
+    }
+
+    // 收到事件、超时和取消三者只有置位 done 的一方写 result 并恢复协程，这里读取时不会再有别的线程访问它
+    AwaitedEvent await_resume() { return AwaitedEvent(std::move(waiter_->result)); }
+
+private:
+    AwaitSubscriber &subscriber_;
+    std::optional<Clock::duration> timeout_;
+    std::shared_ptr<detail::AwaitWaiter> waiter_;
+};
+
+// 等待下一个 event，最多等 timeout，在 executor 上恢复
+template <typename Executor, typename Rep, typename Period>
+NextEventAwaiter<Executor> NextEvent(AwaitSubscriber &subscriber, const char *event,
+                                     std::chrono::duration<Rep, Period> timeout, Executor &executor,
+                                     std::vector<ParamKey> keys = {}) {
+    return NextEventAwaiter<Executor>(subscriber, event,
+                                      std::chrono::duration_cast<detail::AwaitCore::Clock::duration>(timeout),
+                                      executor, std::move(keys));
+}
+
+// 不限时等待下一个 event
+template <typename Executor>
+NextEventAwaiter<Executor> NextEvent(AwaitSubscriber &subscriber, const char *event, Executor &executor,
+                                     std::vector<ParamKey> keys = {}) {
+    return NextEventAwaiter<Executor>(subscriber, event, std::nullopt, executor, std::move(keys));
+}
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_AWAIT_H
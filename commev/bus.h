@@ -0,0 +1,306 @@
+#ifndef COMMONEV_BUS_H
+#define COMMONEV_BUS_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "event.h"
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+/**
+ * @brief 进程内的事件总线：整个进程只向 CES 注册一个订阅者，收到的事件再分发给任意多个本地监听者
+ * @note 只有订阅的事件集合变化时才会重新向 CES 注册；增删监听者不影响已有的注册。
+ *       重新注册时先订阅新的事件集合再退订旧的，切换的瞬间发布的事件可能被漏掉。
+ *       回调线程取分发表时要加一次很短的锁（只拷贝 shared_ptr 并计数），分发本身不持锁
+ */
+class EventBus {
+public:
+    using Listener = std::function<void(const RcvData &)>;
+
+    // 监听句柄，析构或调用 reset() 时注销监听者；返回时正在执行的回调都已结束，此后不会再调用该监听者。
+    // 在本总线的监听者里注销时不等待（否则会等自己），此时当前这次回调之后才保证不再调用
+    class Subscription {
+    public:
+        Subscription() = default;
+        Subscription(const Subscription &) = delete;
+        Subscription &operator=(const Subscription &) = delete;
+        Subscription(Subscription &&other) noexcept
+            : bus_(std::exchange(other.bus_, nullptr)), id_(std::exchange(other.id_, 0)) {}
+        Subscription &operator=(Subscription &&other) noexcept {
+            if (this != &other) {
+                reset();
+                bus_ = std::exchange(other.bus_, nullptr);
+                id_ = std::exchange(other.id_, 0);
+            }
+            return *this;
+        }
+        ~Subscription() { reset(); }
+
+        void reset() {
+            if (bus_) {
+                std::exchange(bus_, nullptr)->remove(id_);
+            }
+        }
+
+        explicit operator bool() const { return bus_ != nullptr; }
+
+    private:
+        friend class EventBus;
+        Subscription(EventBus *bus, std::uint64_t id) : bus_(bus), id_(id) {}
+
+        EventBus *bus_ = nullptr;
+        std::uint64_t id_ = 0;
+    };
+
+    static EventBus &Instance() {
+        static EventBus instance;
+        return instance;
+    }
+
+    EventBus() : table_(std::make_shared<const Table>()) {}
+    ~EventBus() {
+        std::unique_ptr<Subscriber> subscriber;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            subscriber = std::move(subscriber_);
+        }
+        if (subscriber) {
+            subscriber->unSubscribe();
+        }
+    }
+
+    EventBus(const EventBus &) = delete;
+    EventBus &operator=(const EventBus &) = delete;
+
+    // 监听一组事件，事件集合因此扩大时会重新向 CES 注册，注册失败抛出 std::system_error，关闭异常时终止进程
+    [[nodiscard]] Subscription listen(std::vector<std::string> events, Listener listener) {
+        std::sort(events.begin(), events.end());
+        events.erase(std::unique(events.begin(), events.end()), events.end());
+        std::unique_lock<std::mutex> lock(mutex_);
+        const std::uint64_t id = ++nextId_;
+        listeners_.emplace(id, Entry{std::move(events), std::make_shared<const Listener>(std::move(listener))});
+        const common::Expected<std::uint64_t> updated = update(lock);
+        if (!updated) {
+            // update 在注册前已经发布了含新监听者的分发表，撤回
+            listeners_.erase(id);
+            publish(buildTable(collectEvents()));
+            COMMON_THROW_ERROR(updated.error().value(), "EventBus::listen failed to subscribe");
+        }
+        return Subscription(this, id);
+    }
+
+    [[nodiscard]] Subscription listen(const char *event, Listener listener) {
+        return listen(std::vector<std::string>{event}, std::move(listener));
+    }
+
+    // 当前向 CES 订阅的事件
+    std::vector<std::string> events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+
+    // 向 CES 注册过的次数，用来确认增删监听者没有引起多余的注册
+    std::uint64_t registrations() const { return registrations_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        std::vector<std::string> events;
+        std::shared_ptr<const Listener> listener;
+    };
+
+    // 只读快照；监听者用 shared_ptr 持有，注销时正在执行的回调不受影响
+    struct Table {
+        std::unique_ptr<EventDispatcher> dispatcher;
+        std::vector<std::vector<std::shared_ptr<const Listener>>> listeners; // 按 dispatcher 的槽位
+        std::uint64_t version = 0;
+        mutable std::uint32_t running = 0; // 正在用这张表分发的回调数，受 tableMutex_ 保护
+    };
+
+    void remove(std::uint64_t id) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (listeners_.erase(id) == 0) {
+            return;
+        }
+        const common::Expected<std::uint64_t> updated = update(lock);
+        std::uint64_t version = 0;
+        if (updated) {
+            version = *updated;
+        } else {
+            // 重新注册失败时保留旧的注册；去掉该监听者的分发表在注册之前已经发布，
+            // 旧注册多收到的事件在表里找不到监听者，直接丢弃
+            version = publishedVersion_;
+            lock.unlock();
+        }
+        if (dispatching_ != this) {
+            quiesce(version);
+        }
+    }
+
+    std::vector<std::string> collectEvents() const {
+        std::vector<std::string> events;
+        for (const auto &item : listeners_) {
+            events.insert(events.end(), item.second.events.begin(), item.second.events.end());
+        }
+        std::sort(events.begin(), events.end());
+        events.erase(std::unique(events.begin(), events.end()), events.end());
+        return events;
+    }
+
+    // 按当前的监听者建分发表，调用时持有 mutex_
+    std::shared_ptr<Table> buildTable(const std::vector<std::string> &events) const {
+        auto table = std::make_shared<Table>();
+        std::vector<std::pair<const char *, EventDispatcher::Handler>> handlers;
+        handlers.reserve(events.size());
+        for (const auto &event : events) {
+            handlers.emplace_back(event.c_str(), nullptr);
+        }
+        table->dispatcher.reset(new EventDispatcher(handlers.begin(), handlers.end()));
+        table->listeners.resize(events.size());
+        for (const auto &item : listeners_) {
+            for (const auto &event : item.second.events) {
+                table->listeners[table->dispatcher->slotOf(event)].push_back(item.second.listener);
+            }
+        }
+        return table;
+    }
+
+    // 换上新的分发表，返回它的版本号；调用时持有 mutex_
+    std::uint64_t publish(std::shared_ptr<Table> table) {
+        table->version = ++publishedVersion_;
+        std::shared_ptr<const Table> retired;
+        {
+            std::lock_guard<std::mutex> lock(tableMutex_);
+            retired = std::exchange(table_, std::move(table));
+            if (retired->running > 0) {
+                draining_.push_back(retired);
+            }
+        }
+        return publishedVersion_;
+    }
+
+    // 等版本号低于 version 的分发表上的回调全部返回
+    void quiesce(std::uint64_t version) {
+        std::unique_lock<std::mutex> lock(tableMutex_);
+        drained_.wait(lock, [this, version] {
+            return std::none_of(draining_.begin(), draining_.end(), [version](const std::shared_ptr<const Table> &table) {
+                return table->version < version;
+            });
+        });
+    }
+
+    // 按当前的监听者重建并发布分发表，事件集合变化时重新注册，返回发布的版本号；
+    // 持有锁进入，成功时释放锁返回，注册失败时仍持有锁并返回错误码
+    common::Expected<std::uint64_t> update(std::unique_lock<std::mutex> &lock) {
+        std::vector<std::string> events = collectEvents();
+        std::shared_ptr<Table> table = buildTable(events);
+        const EventDispatcher &dispatcher = *table->dispatcher;
+        // 增删监听者与重新注册无关，先让分发表生效：注册失败、沿用旧注册时也不会再调用已注销的监听者。
+        // 旧订阅者收不到新增的事件，多收到的已去掉的事件在新表里找不到，直接丢弃
+        const std::uint64_t version = publish(std::move(table));
+
+        std::unique_ptr<Subscriber> retired;
+        if (events != events_) {
+            std::unique_ptr<Subscriber> subscriber;
+            const std::uint64_t generation = generation_ + 1;
+            if (!events.empty()) {
+                SubscribeInfo info = dispatcher.subscribeInfo();
+                auto created = Subscriber::Create(&info, [this, generation](const RcvData &data) {
+                    if (active_.load(std::memory_order_acquire) == generation) {
+                        dispatch(data);
+                    }
+                });
+                if (!created) {
+                    return common::Unexpected(created.error());
+                }
+                subscriber.reset(new Subscriber(std::move(*created)));
+                if (auto subscribed = subscriber->trySubscribe(); !subscribed) {
+                    return common::Unexpected(subscribed.error());
+                }
+                registrations_.fetch_add(1, std::memory_order_relaxed);
+            }
+            // 新的注册生效后再切换，旧订阅者在切换后收到的事件会被忽略
+            generation_ = generation;
+            active_.store(generation, std::memory_order_release);
+            retired = std::exchange(subscriber_, std::move(subscriber));
+            events_ = std::move(events);
+        }
+        lock.unlock();
+        // 在锁外销毁旧订阅者，它会等已经进入的回调返回，回调里的监听者可能正要增删监听
+        if (retired) {
+            // 旧订阅者随后会被销毁，退订失败也不影响
+            (void)retired->tryUnSubscribe();
+        }
+        return version;
+    }
+
+    void dispatch(const RcvData &data) const {
+        std::shared_ptr<const Table> table;
+        {
+            std::lock_guard<std::mutex> lock(tableMutex_);
+            table = table_;
+            ++table->running;
+        }
+        // 监听者抛出异常时也要计数归零，否则注销会一直等
+        struct Leave {
+            const EventBus *bus;
+            const Table *table;
+            const EventBus *outer;
+            ~Leave() {
+                dispatching_ = outer;
+                std::lock_guard<std::mutex> lock(bus->tableMutex_);
+                if (--table->running == 0 && table != bus->table_.get()) {
+                    auto &draining = bus->draining_;
+                    draining.erase(std::remove_if(draining.begin(), draining.end(),
+                                                  [](const std::shared_ptr<const Table> &item) {
+                                                      return item->running == 0;
+                                                  }),
+                                   draining.end());
+                    bus->drained_.notify_all();
+                }
+            }
+        } leave{this, table.get(), std::exchange(dispatching_, this)};
+
+        const char *event = data.event();
+        const std::size_t slot = event ? table->dispatcher->slotOf(event) : EventDispatcher::npos;
+        if (slot == EventDispatcher::npos) {
+            return;
+        }
+        for (const auto &listener : table->listeners[slot]) {
+            (*listener)(data);
+        }
+    }
+
+    // 当前线程正在哪个总线的回调里，用来识别在监听者里注销的情况
+    static inline thread_local const EventBus *dispatching_ = nullptr;
+
+    mutable std::mutex mutex_;
+    std::map<std::uint64_t, Entry> listeners_;
+    std::uint64_t nextId_ = 0;
+    std::vector<std::string> events_; // 当前注册的事件集合
+    std::uint64_t generation_ = 0;
+    std::unique_ptr<Subscriber> subscriber_;
+    std::uint64_t publishedVersion_ = 0;
+    mutable std::mutex tableMutex_; // 保护 table_、draining_ 和各表的 running
+    mutable std::condition_variable drained_;
+    std::shared_ptr<const Table> table_;
+    mutable std::vector<std::shared_ptr<const Table>> draining_; // 已换下但还有回调在用的分发表
+    std::atomic<std::uint64_t> active_{0};
+    std::atomic<std::uint64_t> registrations_{0};
+};
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_BUS_H
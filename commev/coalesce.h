@@ -0,0 +1,586 @@
+#ifndef COMMONEV_COALESCE_H
+#define COMMONEV_COALESCE_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "event.h"
+#include "pool.h"
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+#if OHOS_API_VERSION >= 18
+
+// 合并批量事件时使用的参数键
+inline constexpr const char kBatchCountKey[] = "batch.count"; // int，本批的更新数
+inline constexpr const char kBatchCodesKey[] = "batch.codes"; // int 数组，每个更新的 code
+inline constexpr const char kBatchDataKey[] = "batch.data";   // char 数组，每个更新的 data 以 '\0' 分隔
+
+/**
+ * @brief 一次待发布的更新：code、data 和参数
+ * @note 只保存值，不创建原生对象；对象可以反复 clear() 后复用，不会重新分配内存
+ */
+class EventUpdate {
+public:
+    struct Field {
+        std::string key;
+        ParamType type;
+        std::string bytes; // 值的原始字节
+    };
+
+    EventUpdate &setCode(std::int32_t code) {
+        code_ = code;
+        return *this;
+    }
+    EventUpdate &setData(std::string_view data) {
+        data_.assign(data.data(), data.size());
+        return *this;
+    }
+
+    EventUpdate &setInt(const char *key, int value) { return set(key, ParamType::Int, &value, sizeof(value)); }
+    EventUpdate &setLong(const char *key, long value) { return set(key, ParamType::Long, &value, sizeof(value)); }
+    EventUpdate &setBool(const char *key, bool value) { return set(key, ParamType::Bool, &value, sizeof(value)); }
+    EventUpdate &setChar(const char *key, char value) { return set(key, ParamType::Char, &value, sizeof(value)); }
+    EventUpdate &setDouble(const char *key, double value) {
+        return set(key, ParamType::Double, &value, sizeof(value));
+    }
+    EventUpdate &setIntArray(const char *key, const int *value, std::size_t num) {
+        return set(key, ParamType::IntArray, value, num * sizeof(int));
+    }
+    EventUpdate &setLongArray(const char *key, const long *value, std::size_t num) {
+        return set(key, ParamType::LongArray, value, num * sizeof(long));
+    }
+    EventUpdate &setBoolArray(const char *key, const bool *value, std::size_t num) {
+        return set(key, ParamType::BoolArray, value, num * sizeof(bool));
+    }
+    EventUpdate &setCharArray(const char *key, std::string_view value) {
+        return set(key, ParamType::CharArray, value.data(), value.size());
+    }
+    EventUpdate &setCharArray(const char *key, const char *value, std::size_t num) {
+        return set(key, ParamType::CharArray, value, num);
+    }
+    EventUpdate &setDoubleArray(const char *key, const double *value, std::size_t num) {
+        return set(key, ParamType::DoubleArray, value, num * sizeof(double));
+    }
+
+    void clear() {
+        code_ = 0;
+        data_.clear();
+        size_ = 0;
+    }
+
+    std::int32_t code() const { return code_; }
+    const std::string &data() const { return data_; }
+    const Field *begin() const { return fields_.data(); }
+    const Field *end() const { return fields_.data() + size_; }
+    const Field *find(std::string_view key) const {
+        auto it = std::find_if(begin(), end(), [key](const Field &field) { return field.key == key; });
+        return it != end() ? it : nullptr;
+    }
+
+    // 逐个字段拷贝，保留已有的内存
+    EventUpdate &assign(const EventUpdate &other) {
+        code_ = other.code_;
+        data_ = other.data_;
+        if (fields_.size() < other.size_) {
+            fields_.resize(other.size_);
+        }
+        for (std::size_t i = 0; i < other.size_; ++i) {
+            fields_[i].key = other.fields_[i].key;
+            fields_[i].type = other.fields_[i].type;
+            fields_[i].bytes = other.fields_[i].bytes;
+        }
+        size_ = other.size_;
+        return *this;
+    }
+
+    // 把全部内容写进租借的发布对象
+    void applyTo(PublishPool::Lease &lease) const {
+        lease.setCode(code_);
+        lease.setData(data_);
+        for (const Field &field : *this) {
+            const char *key = field.key.c_str();
+            const char *value = field.bytes.data();
+            const std::size_t size = field.bytes.size();
+            switch (field.type) {
+            case ParamType::Int:
+                lease.setInt(key, Load<int>(value));
+                break;
+            case ParamType::Long:
+                lease.setLong(key, Load<long>(value));
+                break;
+            case ParamType::Bool:
+                lease.setBool(key, Load<bool>(value));
+                break;
+            case ParamType::Char:
+                lease.setChar(key, *value);
+                break;
+            case ParamType::Double:
+                lease.setDouble(key, Load<double>(value));
+                break;
+            case ParamType::IntArray:
+                lease.setIntArray(key, reinterpret_cast<const int *>(value), size / sizeof(int));
+                break;
+            case ParamType::LongArray:
+                lease.setLongArray(key, reinterpret_cast<const long *>(value), size / sizeof(long));
+                break;
+            case ParamType::BoolArray:
+                lease.setBoolArray(key, reinterpret_cast<const bool *>(value), size / sizeof(bool));
+                break;
+            case ParamType::CharArray:
+                lease.setCharArray(key, std::string_view(value, size));
+                break;
+            case ParamType::DoubleArray:
+                lease.setDoubleArray(key, reinterpret_cast<const double *>(value), size / sizeof(double));
+                break;
+            }
+        }
+    }
+
+    template <typename T> static T Load(const char *bytes) {
+        T value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+private:
+    EventUpdate &set(const char *key, ParamType type, const void *value, std::size_t size) {
+        Field *field = std::find_if(fields_.data(), fields_.data() + size_,
+                                    [key](const Field &candidate) { return candidate.key == key; });
+        if (field == fields_.data() + size_) {
+            if (size_ == fields_.size()) {
+                fields_.emplace_back();
+                field = &fields_.back();
+            } else {
+                field = &fields_[size_];
+            }
+            field->key = key;
+            ++size_;
+        }
+        field->type = type;
+        field->bytes.assign(static_cast<const char *>(value), size);
+        return *this;
+    }
+
+    std::int32_t code_ = 0;
+    std::string data_;
+    std::vector<Field> fields_;
+    std::size_t size_ = 0; // fields_ 中有效的个数，其余的留着复用
+};
+
+// 同名同 code 的事件在窗口内只发布最后一次
+struct CoalesceOptions {
+    std::chrono::milliseconds window{10};
+    // 大于0时每次更新都把发布时间推迟到 window 之后，但离第一次更新不超过 maxLatency；
+    // 为0时从第一次更新起固定等待 window
+    std::chrono::milliseconds maxLatency{0};
+};
+
+// 窗口内的多个更新打包成一个事件发布
+struct BatchOptions {
+    std::chrono::milliseconds window{10};
+    std::size_t maxBatch = 64; // 攒够这么多个更新就立即发布
+};
+
+struct CoalesceMetrics {
+    std::uint64_t submitted = 0; // 提交的更新数
+    std::uint64_t published = 0; // 实际调用 Publish 的次数
+    std::uint64_t coalesced = 0; // 被后来的更新覆盖掉的更新数
+    std::uint64_t batched = 0;   // 打包进批量事件的更新数
+    std::uint64_t failed = 0;    // 后台发布失败的次数
+};
+
+/**
+ * @brief 在 Publish 之前合并同一事件的高频更新，减少发往 CES 的 IPC 次数
+ * @note 没有配置过的事件直接在调用线程发布。配置过的事件由后台线程在截止时间发布，
+ *       后台发布失败时不抛异常，只计入 metrics().failed 并记下 lastError()。
+ *       批量事件的参数按列打包：每个标量参数变成同名数组，某个更新没带的位置填0，
+ *       另外带上 kBatchCountKey、kBatchCodesKey、kBatchDataKey；批量事件的 code 为更新数，
+ *       更新中不能带数组参数。
+ *       析构时发布完所有未到期的更新
+ */
+class CoalescingPublisher {
+public:
+    using clock = std::chrono::steady_clock;
+
+    CoalescingPublisher() = default;
+    CoalescingPublisher(const CoalescingPublisher &) = delete;
+    CoalescingPublisher &operator=(const CoalescingPublisher &) = delete;
+
+    ~CoalescingPublisher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeup_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+        flush();
+    }
+
+    void coalesce(const std::string &event, const CoalesceOptions &options) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Channel &channel = channelOf(event);
+        channel.batch = false;
+        channel.coalesce = options;
+    }
+
+    void batch(const std::string &event, const BatchOptions &options) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Channel &channel = channelOf(event);
+        channel.batch = true;
+        channel.batching = options;
+    }
+
+    void publish(const char *event, const EventUpdate &update = EventUpdate()) {
+        const auto now = clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++metrics_.submitted;
+        Channel *channel = findChannel(event);
+        if (!channel) {
+            lock.unlock();
+            send(event, update);
+            lock.lock();
+            ++metrics_.published;
+            return;
+        }
+        if (channel->batch) {
+            for (const auto &field : update) {
+                if (!IsScalar(field.type)) {
+                    COMMON_THROW_ERROR(COMMONEVENT_ERR_INVALID_PARAMETER, "array parameter in batched update");
+                }
+            }
+            // 攒满的批次等后台线程发布，新的更新进入下一个批次
+            const std::size_t maxBatch = std::max<std::size_t>(channel->batching.maxBatch, 1);
+            auto it = std::find_if(channel->pending.begin(), channel->pending.end(), [maxBatch](const Pending &pending) {
+                return pending.count > 0 && pending.count < maxBatch;
+            });
+            if (it == channel->pending.end()) {
+                it = std::find_if(channel->pending.begin(), channel->pending.end(),
+                                  [](const Pending &pending) { return pending.count == 0; });
+            }
+            if (it == channel->pending.end()) {
+                it = channel->pending.emplace(channel->pending.end());
+            }
+            Pending &pending = *it;
+            if (pending.count == 0) {
+                pending.first = now;
+                pending.deadline = now + channel->batching.window;
+            }
+            if (pending.updates.size() == pending.count) {
+                pending.updates.emplace_back();
+            }
+            pending.updates[pending.count++].assign(update);
+            if (pending.count >= maxBatch) {
+                pending.deadline = now;
+            }
+            schedule(pending.deadline);
+            return;
+        }
+
+        auto it = std::find_if(channel->pending.begin(), channel->pending.end(),
+                               [&update](const Pending &pending) { return pending.code == update.code(); });
+        if (it == channel->pending.end()) {
+            it = std::find_if(channel->pending.begin(), channel->pending.end(),
+                              [](const Pending &pending) { return pending.count == 0; });
+            if (it == channel->pending.end()) {
+                it = channel->pending.emplace(channel->pending.end());
+            }
+            it->code = update.code();
+        }
+        Pending &pending = *it;
+        if (pending.updates.empty()) {
+            pending.updates.emplace_back();
+        }
+        if (pending.count == 0) {
+            pending.first = now;
+            // maxLatency 比 window 短时，第一次更新也不能等满 window
+            const auto &policy = channel->coalesce;
+            pending.deadline =
+                now + (policy.maxLatency.count() > 0 ? std::min(policy.window, policy.maxLatency) : policy.window);
+            pending.count = 1;
+        } else {
+            ++metrics_.coalesced;
+            if (channel->coalesce.maxLatency.count() > 0) {
+                pending.deadline = std::min(now + channel->coalesce.window, pending.first + channel->coalesce.maxLatency);
+            }
+        }
+        pending.updates.front().assign(update);
+        schedule(pending.deadline);
+    }
+
+    // 立即发布所有攒着的更新
+    void flush() { drain(clock::time_point::max()); }
+
+    CoalesceMetrics metrics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return metrics_;
+    }
+
+    std::error_code lastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastError_;
+    }
+
+private:
+    struct Pending {
+        std::int32_t code = 0;
+        std::size_t count = 0; // 0表示空闲
+        clock::time_point first;
+        clock::time_point deadline;
+        std::vector<EventUpdate> updates; // 合并模式只用第一个
+    };
+
+    struct Outgoing {
+        std::string event;
+        bool batch = false;
+        clock::time_point first;
+        std::size_t count = 0;
+        std::vector<EventUpdate> updates;
+    };
+
+    struct Channel {
+        std::string event;
+        bool batch = false;
+        CoalesceOptions coalesce;
+        BatchOptions batching;
+        std::vector<Pending> pending;
+    };
+
+    static bool IsScalar(ParamType type) {
+        return type == ParamType::Int || type == ParamType::Long || type == ParamType::Bool ||
+               type == ParamType::Char || type == ParamType::Double;
+    }
+
+    Channel *findChannel(std::string_view event) {
+        for (auto &channel : channels_) {
+            if (channel.event == event) {
+                return &channel;
+            }
+        }
+        return nullptr;
+    }
+
+    Channel &channelOf(const std::string &event) {
+        if (Channel *channel = findChannel(event)) {
+            return *channel;
+        }
+        channels_.emplace_back();
+        channels_.back().event = event;
+        return channels_.back();
+    }
+
+    // 调用时持有 mutex_
+    void schedule(clock::time_point deadline) {
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&CoalescingPublisher::run, this);
+        }
+        if (deadline < nextDeadline_) {
+            nextDeadline_ = deadline;
+            wakeup_.notify_one();
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            if (nextDeadline_ == clock::time_point::max()) {
+                wakeup_.wait(lock);
+            } else {
+                wakeup_.wait_until(lock, nextDeadline_);
+            }
+            if (stopping_) {
+                break;
+            }
+            const auto now = clock::now();
+            if (now < nextDeadline_) {
+                continue;
+            }
+            lock.unlock();
+            drain(now);
+            lock.lock();
+        }
+    }
+
+    // 发布截止时间不晚于 now 的更新
+    void drain(clock::time_point now) {
+        std::lock_guard<std::mutex> publishLock(publishMutex_);
+        std::size_t outgoing = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            nextDeadline_ = clock::time_point::max();
+            for (auto &channel : channels_) {
+                for (auto &pending : channel.pending) {
+                    if (pending.count == 0) {
+                        continue;
+                    }
+                    if (pending.deadline > now) {
+                        nextDeadline_ = std::min(nextDeadline_, pending.deadline);
+                        continue;
+                    }
+                    // 和发件箱交换存储，解锁后新的更新写进换过来的空间，两边都不用重新分配
+                    if (outbox_.size() == outgoing) {
+                        outbox_.emplace_back();
+                    }
+                    Outgoing &out = outbox_[outgoing++];
+                    out.event = channel.event;
+                    out.batch = channel.batch;
+                    out.first = pending.first;
+                    out.count = std::exchange(pending.count, 0);
+                    std::swap(out.updates, pending.updates);
+                }
+            }
+        }
+        // 同一事件可能有多个到期的批次，按第一个更新的时间发布
+        std::sort(outbox_.begin(), outbox_.begin() + outgoing,
+                  [](const Outgoing &a, const Outgoing &b) { return a.first < b.first; });
+
+        std::size_t published = 0;
+        std::size_t batched = 0;
+        std::error_code error;
+        for (std::size_t i = 0; i < outgoing; ++i) {
+            const Outgoing &out = outbox_[i];
+            const common::Expected<void> result = sendOutgoing(out);
+            if (!result) {
+                error = result.error();
+                continue;
+            }
+            if (out.batch) {
+                batched += out.count;
+            }
+            ++published;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        metrics_.published += published;
+        metrics_.batched += batched;
+        if (error) {
+            metrics_.failed += outgoing - published;
+            lastError_ = error;
+        }
+    }
+
+    // 发布失败返回错误码；设置参数失败时开启异常的构建同样转成错误码，关闭异常的构建直接终止进程
+    common::Expected<void> sendOutgoing(const Outgoing &out) {
+#if defined(__cpp_exceptions)
+        try {
+            return out.batch ? sendBatch(out.event.c_str(), out.updates.data(), out.count)
+                             : send(out.event.c_str(), out.updates.front());
+        } catch (const std::system_error &e) {
+            return common::Unexpected(e.code());
+        }
+#else
+        return out.batch ? sendBatch(out.event.c_str(), out.updates.data(), out.count)
+                         : send(out.event.c_str(), out.updates.front());
+#endif
+    }
+
+    common::Expected<void> send(const char *event, const EventUpdate &update) {
+        auto lease = pool_.acquire();
+        update.applyTo(lease);
+        return lease.tryPublish(event);
+    }
+
+    // 调用时持有 publishMutex_
+    common::Expected<void> sendBatch(const char *event, const EventUpdate *updates, std::size_t count) {
+        auto lease = pool_.acquire();
+        lease.setCode(static_cast<std::int32_t>(count));
+        lease.setInt(kBatchCountKey, static_cast<int>(count));
+
+        columnInts_.clear();
+        packed_.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            columnInts_.push_back(updates[i].code());
+            packed_.append(updates[i].data());
+            packed_.push_back('\0');
+        }
+        lease.setIntArray(kBatchCodesKey, columnInts_.data(), columnInts_.size());
+        lease.setCharArray(kBatchDataKey, packed_);
+
+        // 按第一次出现的顺序为每个参数键生成一列
+        keys_.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            for (const auto &field : updates[i]) {
+                auto it = std::find_if(keys_.begin(), keys_.end(),
+                                       [&field](const EventUpdate::Field *key) { return key->key == field.key; });
+                if (it == keys_.end()) {
+                    keys_.push_back(&field);
+                }
+            }
+        }
+        for (const EventUpdate::Field *key : keys_) {
+            packColumn(lease, updates, count, *key);
+        }
+        return lease.tryPublish(event);
+    }
+
+    void packColumn(PublishPool::Lease &lease, const EventUpdate *updates, std::size_t count,
+                    const EventUpdate::Field &key) {
+        column_.assign(count * key.bytes.size(), '\0');
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto *field = updates[i].find(key.key);
+            if (field && field->type == key.type) {
+                std::memcpy(&column_[i * key.bytes.size()], field->bytes.data(), key.bytes.size());
+            }
+        }
+        const char *name = key.key.c_str();
+        switch (key.type) {
+        case ParamType::Int:
+            lease.setIntArray(name, reinterpret_cast<const int *>(column_.data()), count);
+            break;
+        case ParamType::Long:
+            lease.setLongArray(name, reinterpret_cast<const long *>(column_.data()), count);
+            break;
+        case ParamType::Bool:
+            lease.setBoolArray(name, reinterpret_cast<const bool *>(column_.data()), count);
+            break;
+        case ParamType::Char:
+            lease.setCharArray(name, column_);
+            break;
+        case ParamType::Double:
+            lease.setDoubleArray(name, reinterpret_cast<const double *>(column_.data()), count);
+            break;
+        default:
+            break;
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::vector<Channel> channels_;
+    clock::time_point nextDeadline_ = clock::time_point::max();
+    bool stopping_ = false;
+    CoalesceMetrics metrics_;
+    std::error_code lastError_;
+    std::thread worker_;
+
+    PublishPool pool_;
+
+    // 以下只在持有 publishMutex_ 时使用
+    std::mutex publishMutex_;
+    std::vector<Outgoing> outbox_;
+    std::vector<int> columnInts_;
+    std::string packed_;
+    std::string column_;
+    std::vector<const EventUpdate::Field *> keys_;
+};
+
+#endif
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_COALESCE_H
@@ -2,8 +2,11 @@
 #define COMMONEV_ERROR_H
 
 #include <BasicServicesKit/oh_commonevent.h>
+#include <cstdlib>
 #include <system_error>
 
+#include "expected.h"
+
 namespace std {
 template <> struct is_error_code_enum<CommonEvent_ErrCode> : public true_type {};
 } // namespace std
@@ -12,9 +15,16 @@ namespace OHOS {
 namespace common {
 namespace event {
 
+// 关闭异常时出错直接终止进程，需要处理错误的路径请改用返回 Expected 的 try* 接口
+#if defined(__cpp_exceptions)
+# define COMMON_THROW_ERROR(code, message) throw std::system_error((code), CommonEventErrCategory::Instance(), (message))
+#else
+# define COMMON_THROW_ERROR(code, message) std::abort()
+#endif
+
 #define COMMON_CHECK_ERROR(exp, message)                                                                               \
     if (auto __code = (exp); __code != COMMONEVENT_ERR_OK)                                                             \
-    throw std::system_error(__code, CommonEventErrCategory::Instance(), (message))
+    COMMON_THROW_ERROR(__code, message)
 
 #define COMMON_CHECK_ERROR_INLINE_DEFAULT(exp) COMMON_CHECK_ERROR(exp, #exp)
 
@@ -57,6 +67,18 @@ private:
     CommonEventErrCategory() = default;
 };
 
+inline std::error_code MakeErrorCode(CommonEvent_ErrCode code) {
+    return std::error_code(code, CommonEventErrCategory::Instance());
+}
+
+// 把 NDK 的返回值转成不抛异常的接口的结果
+inline Expected<void> ToExpected(CommonEvent_ErrCode code) {
+    if (code != COMMONEVENT_ERR_OK) {
+        return Unexpected(MakeErrorCode(code));
+    }
+    return {};
+}
+
 } // namespace event
 } // namespace common
 } // namespace OHOS
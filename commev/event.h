@@ -3,26 +3,93 @@
 
 #include <BasicServicesKit/oh_commonevent.h>
 #include <BasicServicesKit/oh_commonevent_support.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#if __has_include(<span>)
+# include <span>
+#endif
 
 #include "error.h"
+#include "metrics.h"
 
 namespace OHOS {
 namespace common {
 namespace event {
 
+// 指向 Parameters 内部数组的只读视图，在 RcvData 的生命周期内有效
+#if defined(__cpp_lib_span) && __cpp_lib_span >= 202002L
+template <typename T> using ArrayView = std::span<const T>;
+#else
+template <typename T> class ArrayView {
+public:
+    constexpr ArrayView() = default;
+    constexpr ArrayView(const T *data, std::size_t size) : data_(data), size_(size) {}
+
+    constexpr const T *data() const { return data_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr const T *begin() const { return data_; }
+    constexpr const T *end() const { return data_ + size_; }
+    constexpr const T &operator[](std::size_t i) const { return data_[i]; }
+
+private:
+    const T *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+#endif
+
+// 参数的类型，决定读取时调用哪个 OH_CommonEvent_Get*FromParameters
+enum class ParamType : std::uint8_t {
+    Int,
+    Long,
+    Bool,
+    Char,
+    Double,
+    IntArray,
+    LongArray,
+    BoolArray,
+    CharArray,
+    DoubleArray,
+};
+
+struct ParamKey {
+    std::string key;
+    ParamType type;
+};
+
 class Parameters {
 public:
     using param_type = CommonEvent_Parameters;
-    Parameters(const param_type *param) : param_(param) {}
-#if OHOS_API_VERSION >= 18
-    explicit Parameters() : param_(OH_CommonEvent_CreateParameters()) {}
-    ~Parameters() {
-        if (param_) {
-            OH_CommonEvent_DestroyParameters(param_);
+    // 引用收到的事件里的参数，不负责释放
+    Parameters(const param_type *param) : param_(const_cast<param_type *>(param)) {}
+
+    Parameters(const Parameters &) = delete;
+    Parameters &operator=(const Parameters &) = delete;
+    Parameters(Parameters &&other) noexcept
+        : param_(std::exchange(other.param_, nullptr)), owned_(std::exchange(other.owned_, false)) {}
+    Parameters &operator=(Parameters &&other) noexcept {
+        if (this != &other) {
+            reset();
+            param_ = std::exchange(other.param_, nullptr);
+            owned_ = std::exchange(other.owned_, false);
         }
+        return *this;
     }
+    ~Parameters() { reset(); }
+
+#if OHOS_API_VERSION >= 18
+    // 新建一组参数用于发布，析构时释放
+    explicit Parameters() : param_(OH_CommonEvent_CreateParameters()), owned_(true) {}
 
     void setInt(const char *key, int value) const {
         COMMON_CHECK_ERROR_INLINE_DEFAULT(OH_CommonEvent_SetIntToParameters(param_, key, value));
@@ -67,6 +134,9 @@ public:
     void setCharArray(const char *key, const char *value) const {
         COMMON_CHECK_ERROR_INLINE_DEFAULT(OH_CommonEvent_SetCharArrayToParameters(param_, key, value, strlen(value)));
     }
+    void setCharArray(const char *key, const char *value, std::size_t num) const {
+        COMMON_CHECK_ERROR_INLINE_DEFAULT(OH_CommonEvent_SetCharArrayToParameters(param_, key, value, num));
+    }
 
     void setDouble(const char *key, double value) const {
         COMMON_CHECK_ERROR_INLINE_DEFAULT(OH_CommonEvent_SetDoubleToParameters(param_, key, value));
@@ -127,11 +197,95 @@ public:
         return std::vector<double>(array, array + len);
     }
 
+    // 以下 *View 版本直接引用 Parameters 内部的数组，不做拷贝，在 RcvData 的生命周期内有效
+    ArrayView<int> getIntArrayView(const char *key) const {
+        int *array = nullptr;
+        return MakeView(array, OH_CommonEvent_GetIntArrayFromParameters(param_, key, &array));
+    }
+    ArrayView<long> getLongArrayView(const char *key) const {
+        long *array = nullptr;
+        return MakeView(array, OH_CommonEvent_GetLongArrayFromParameters(param_, key, &array));
+    }
+    ArrayView<bool> getBoolArrayView(const char *key) const {
+        bool *array = nullptr;
+        return MakeView(array, OH_CommonEvent_GetBoolArrayFromParameters(param_, key, &array));
+    }
+    std::string_view getCharArrayView(const char *key) const {
+        char *array = nullptr;
+        const std::int32_t len = OH_CommonEvent_GetCharArrayFromParameters(param_, key, &array);
+        return array && len > 0 ? std::string_view(array, len) : std::string_view();
+    }
+    ArrayView<double> getDoubleArrayView(const char *key) const {
+        double *array = nullptr;
+        return MakeView(array, OH_CommonEvent_GetDoubleArrayFromParameters(param_, key, &array));
+    }
+
+    /**
+     * @brief 按 keys 依次读取参数，对存在的 key 调用 visitor(key, value)，不存在的跳过
+     * @note NDK 没有遍历全部 key 的接口，需要的 key 和类型由调用方列出；
+     *       value 为 int/long/bool/char/double 或对应的 ArrayView/std::string_view，数组不做拷贝
+     */
+    template <typename Visitor> void visit(const std::vector<ParamKey> &keys, Visitor &&visitor) const {
+        for (const auto &item : keys) {
+            const char *key = item.key.c_str();
+            if (!hasKey(key)) {
+                continue;
+            }
+            switch (item.type) {
+            case ParamType::Int:
+                visitor(item.key, getInt(key, 0));
+                break;
+            case ParamType::Long:
+                visitor(item.key, getLong(key, 0));
+                break;
+            case ParamType::Bool:
+                visitor(item.key, getBool(key, false));
+                break;
+            case ParamType::Char:
+                visitor(item.key, getChar(key, '\0'));
+                break;
+            case ParamType::Double:
+                visitor(item.key, getDouble(key, 0.0));
+                break;
+            case ParamType::IntArray:
+                visitor(item.key, getIntArrayView(key));
+                break;
+            case ParamType::LongArray:
+                visitor(item.key, getLongArrayView(key));
+                break;
+            case ParamType::BoolArray:
+                visitor(item.key, getBoolArrayView(key));
+                break;
+            case ParamType::CharArray:
+                visitor(item.key, getCharArrayView(key));
+                break;
+            case ParamType::DoubleArray:
+                visitor(item.key, getDoubleArrayView(key));
+                break;
+            }
+        }
+    }
+
     const param_type *parameters() const { return param_; }
     operator const param_type *() const { return parameters(); }
 
 private:
-    const param_type *param_;
+    template <typename T> static ArrayView<T> MakeView(const T *array, std::int32_t len) {
+        return array && len > 0 ? ArrayView<T>(array, static_cast<std::size_t>(len)) : ArrayView<T>();
+    }
+
+    void reset() {
+#if OHOS_API_VERSION >= 18
+        if (owned_ && param_) {
+            OH_CommonEvent_DestroyParameters(param_);
+        }
+#endif
+        param_ = nullptr;
+        owned_ = false;
+    }
+
+    param_type *param_ = nullptr;
+    bool owned_ = false;
 };
 
 class SubscribeInfo {
@@ -196,6 +350,137 @@ private:
     const data_type *data_;
 };
 
+// 同时存在的带闭包订阅者的上限，每个占用一个回调函数槽位
+#ifndef COMMEV_MAX_CLOSURE_SUBSCRIBERS
+# define COMMEV_MAX_CLOSURE_SUBSCRIBERS 64
+#endif
+
+namespace detail {
+
+/**
+ * @brief 带闭包订阅者的登记表
+ * @note CES 的回调只带 RcvData，分不出是哪个订阅者收到的，所以每个槽位生成一个独立的回调函数，
+ *       回调里按槽位下标直接取出闭包，只有几次原子操作，不加锁
+ */
+class CallbackRegistry {
+public:
+    using Callback = std::function<void(const RcvData &, CommonEvent_Subscriber *)>;
+    static constexpr std::size_t kCapacity = COMMEV_MAX_CLOSURE_SUBSCRIBERS;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // 占用一个空闲槽位，槽位用完时返回 npos
+    static std::size_t TryAcquire() {
+        auto &slots = Slots();
+        for (std::size_t i = 0; i < kCapacity; ++i) {
+            bool expected = false;
+            if (!slots[i].used.load(std::memory_order_relaxed) && slots[i].used.compare_exchange_strong(expected, true)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    // 同 TryAcquire，槽位用完时抛出 std::system_error
+    static std::size_t Acquire() {
+        const std::size_t slot = TryAcquire();
+        if (slot == npos) {
+            COMMON_THROW_ERROR(COMMONEVENT_ERR_SUBSCRIBER_NUM_EXCEEDED,
+                               "no free closure subscriber slot, raise COMMEV_MAX_CLOSURE_SUBSCRIBERS");
+        }
+        return slot;
+    }
+
+    static CommonEvent_ReceiveCallback TrampolineOf(std::size_t slot) {
+        return MakeTrampolines(std::make_index_sequence<kCapacity>())[slot];
+    }
+
+    static void Bind(std::size_t slot, CommonEvent_Subscriber *subscriber, Callback callback) {
+        Slots()[slot].handled.store(0, std::memory_order_relaxed);
+        Slots()[slot].stats.clear();
+        Slots()[slot].entry.store(new Entry{subscriber, std::move(callback)});
+    }
+
+    // 归还一个占用后还没有 Bind 的槽位，原生订阅者没能创建时使用；没有回调会进入这样的槽位，直接清掉占用标记
+    static void Abandon(std::size_t slot) { Slots()[slot].used.store(false); }
+
+    // 槽位当前的订阅者收到的事件数，COMMEV_METRICS=0 时恒为 0
+    static std::uint64_t Handled(std::size_t slot) { return Slots()[slot].handled.load(std::memory_order_relaxed); }
+
+    // 解绑并归还槽位；等正在执行的回调返回后再释放闭包，在该槽位自己的回调里调用时由回调返回时释放
+    static void Release(std::size_t slot) {
+        Slot &target = Slots()[slot];
+        target.retired.store(target.entry.exchange(nullptr));
+        if (CurrentSlot() == slot) {
+            return;
+        }
+        while (target.readers.load() != 0) {
+            std::this_thread::yield();
+        }
+        Reclaim(target);
+    }
+
+private:
+    struct Entry {
+        CommonEvent_Subscriber *subscriber;
+        Callback callback;
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<Entry *> entry{nullptr};
+        std::atomic<Entry *> retired{nullptr};
+        std::atomic<std::uint32_t> readers{0}; // 正在执行的回调数
+        std::atomic<std::uint64_t> handled{0};
+        std::atomic<bool> used{false};
+        EventStatsCache stats; // 该槽位的订阅者收到的各事件的统计项
+    };
+
+    static std::array<Slot, kCapacity> &Slots() {
+        static std::array<Slot, kCapacity> slots;
+        return slots;
+    }
+
+    // 当前线程正在执行的回调所在的槽位
+    static std::size_t &CurrentSlot() {
+        thread_local std::size_t slot = npos;
+        return slot;
+    }
+
+    static void Reclaim(Slot &slot) {
+        if (Entry *entry = slot.retired.exchange(nullptr)) {
+            delete entry;
+            slot.used.store(false);
+        }
+    }
+
+    // readers 和 entry 都用顺序一致的原子操作：要么回调看到 entry 已被摘除，要么 Release 看到回调还在执行
+    template <std::size_t I> static void Trampoline(const CommonEvent_RcvData *data) {
+        Slot &slot = Slots()[I];
+        slot.readers.fetch_add(1);
+        if (Entry *entry = slot.entry.load()) {
+            struct Scope {
+                std::size_t outer = std::exchange(CurrentSlot(), I);
+                ~Scope() { CurrentSlot() = outer; }
+            } scope;
+#if COMMEV_METRICS
+            slot.handled.fetch_add(1, std::memory_order_relaxed);
+#endif
+            HandlerTimer timer(data, slot.stats);
+            entry->callback(RcvData(data), entry->subscriber);
+        }
+        if (slot.readers.fetch_sub(1) == 1) {
+            Reclaim(slot);
+        }
+    }
+
+    template <std::size_t... I>
+    static const std::array<CommonEvent_ReceiveCallback, kCapacity> &MakeTrampolines(std::index_sequence<I...>) {
+        static const std::array<CommonEvent_ReceiveCallback, kCapacity> trampolines{&Trampoline<I>...};
+        return trampolines;
+    }
+};
+
+} // namespace detail
+
 class Subscriber {
 public:
     using subcriber_type = CommonEvent_Subscriber;
@@ -205,31 +490,280 @@ public:
         subscriber_ = OH_CommonEvent_CreateSubscriber(info->info(), callback);
     }
 
+    /**
+     * @brief 以任意可调用对象作为回调，参数为 (const RcvData &) 或 (const RcvData &, subcriber_type *)
+     * @note 同一进程可以有多个互不相干的订阅者，不必再借助单例；
+     *       最多同时存在 COMMEV_MAX_CLOSURE_SUBSCRIBERS 个，超出或 NDK 没能创建订阅者时抛出 std::system_error
+     */
+    template <typename Callable,
+              typename = std::enable_if_t<!std::is_convertible_v<std::decay_t<Callable>, ReceiveCallback>>>
+    Subscriber(const SubscribeInfo *info, Callable &&callback) : slot_(detail::CallbackRegistry::Acquire()) {
+        subscriber_ = OH_CommonEvent_CreateSubscriber(info->info(), detail::CallbackRegistry::TrampolineOf(slot_));
+        if (!subscriber_) {
+            // 构造函数抛出时不会析构，先自己归还槽位
+            detail::CallbackRegistry::Abandon(std::exchange(slot_, detail::CallbackRegistry::npos));
+            COMMON_THROW_ERROR(COMMONEVENT_ERR_INVALID_PARAMETER, "OH_CommonEvent_CreateSubscriber failed");
+        }
+        bind(std::forward<Callable>(callback));
+    }
+
+    /**
+     * @brief 不抛异常的构造方式，参数同构造函数
+     * @return 创建失败时返回错误码：槽位用完为 COMMONEVENT_ERR_SUBSCRIBER_NUM_EXCEEDED，
+     *         NDK 没能创建订阅者为 COMMONEVENT_ERR_INVALID_PARAMETER
+     */
+    template <typename Callback> static common::Expected<Subscriber> Create(const SubscribeInfo *info, Callback &&callback) {
+        Subscriber subscriber;
+        if constexpr (std::is_convertible_v<std::decay_t<Callback>, ReceiveCallback>) {
+            subscriber.subscriber_ = OH_CommonEvent_CreateSubscriber(info->info(), callback);
+        } else {
+            subscriber.slot_ = detail::CallbackRegistry::TryAcquire();
+            if (subscriber.slot_ == detail::CallbackRegistry::npos) {
+                return common::Unexpected(MakeErrorCode(COMMONEVENT_ERR_SUBSCRIBER_NUM_EXCEEDED));
+            }
+            subscriber.subscriber_ =
+                OH_CommonEvent_CreateSubscriber(info->info(), detail::CallbackRegistry::TrampolineOf(subscriber.slot_));
+            if (subscriber.subscriber_) {
+                subscriber.bind(std::forward<Callback>(callback));
+            } else {
+                detail::CallbackRegistry::Abandon(std::exchange(subscriber.slot_, detail::CallbackRegistry::npos));
+            }
+        }
+        if (!subscriber.subscriber_) {
+            return common::Unexpected(MakeErrorCode(COMMONEVENT_ERR_INVALID_PARAMETER));
+        }
+        return subscriber;
+    }
+
     Subscriber(const Subscriber &) = delete;
     Subscriber &operator=(const Subscriber &) = delete;
-    Subscriber(Subscriber &&other) noexcept : subscriber_(std::exchange(other.subscriber_, nullptr)) {}
+    Subscriber(Subscriber &&other) noexcept
+        : subscriber_(std::exchange(other.subscriber_, nullptr)),
+          slot_(std::exchange(other.slot_, detail::CallbackRegistry::npos)) {}
     Subscriber &operator=(Subscriber &&other) noexcept {
         if (this != &other) {
-            OH_CommonEvent_DestroySubscriber(subscriber_);
+            release();
             subscriber_ = std::exchange(other.subscriber_, nullptr);
+            slot_ = std::exchange(other.slot_, detail::CallbackRegistry::npos);
         }
         return *this;
     }
 
-    ~Subscriber() {
-        if (subscriber_)
-            OH_CommonEvent_DestroySubscriber(subscriber_);
-    }
+    ~Subscriber() { release(); }
 
     void subscribe() const { COMMON_CHECK_ERROR_INLINE_DEFAULT(OH_CommonEvent_Subscribe(subscriber_)); }
 
     void unSubscribe() const { COMMON_CHECK_ERROR_INLINE_DEFAULT(OH_CommonEvent_UnSubscribe(subscriber_)); }
 
+    // 不抛异常的版本，失败时返回错误码
+    common::Expected<void> trySubscribe() const { return ToExpected(OH_CommonEvent_Subscribe(subscriber_)); }
+    common::Expected<void> tryUnSubscribe() const { return ToExpected(OH_CommonEvent_UnSubscribe(subscriber_)); }
+
     subcriber_type *subscriber() const { return subscriber_; }
     operator subcriber_type *() const { return subscriber(); }
 
+    // 带闭包的订阅者收到的事件数，以函数指针为回调或 COMMEV_METRICS=0 时为 0
+    std::uint64_t handled() const {
+        return slot_ != detail::CallbackRegistry::npos ? detail::CallbackRegistry::Handled(slot_) : 0;
+    }
+
 private:
+    Subscriber() = default;
+
+    template <typename Callable> void bind(Callable &&callback) {
+        if constexpr (std::is_invocable_v<Callable &, const RcvData &, subcriber_type *>) {
+            detail::CallbackRegistry::Bind(slot_, subscriber_, std::forward<Callable>(callback));
+        } else {
+            detail::CallbackRegistry::Bind(
+                slot_, subscriber_,
+                [callback = std::forward<Callable>(callback)](const RcvData &data, subcriber_type *) mutable {
+                    callback(data);
+                });
+        }
+    }
+
+    void release() {
+        if (subscriber_) {
+            OH_CommonEvent_DestroySubscriber(subscriber_);
+            subscriber_ = nullptr;
+        }
+        // 先销毁原生订阅者，之后不会再有新的回调，再等已经进入的回调结束
+        if (slot_ != detail::CallbackRegistry::npos) {
+            detail::CallbackRegistry::Release(slot_);
+            slot_ = detail::CallbackRegistry::npos;
+        }
+    }
+
     subcriber_type *subscriber_ = nullptr;
+    std::size_t slot_ = detail::CallbackRegistry::npos; // 带闭包时占用的槽位
+};
+
+/**
+ * @brief 事件名到处理函数的分发表，构造时把订阅的事件名建成完美哈希表，收到事件时只需算一次哈希、比较一次字符串
+ * @note 构造后只读，CES 在多个线程上回调时可以并发查找；用 subscribeInfo() 创建订阅，保证订阅的事件和表中一致
+ */
+class EventDispatcher {
+public:
+    using Handler = std::function<void(const RcvData &)>;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    EventDispatcher(std::initializer_list<std::pair<const char *, Handler>> handlers)
+        : EventDispatcher(handlers.begin(), handlers.end()) {}
+
+    // 迭代器的元素需要有 first（事件名）和 second（处理函数）；事件名重复时抛出 std::system_error
+    template <typename Iterator> EventDispatcher(Iterator first, Iterator last) {
+        for (; first != last; ++first) {
+            names_.emplace_back(first->first);
+            handlers_.emplace_back(first->second);
+        }
+        build();
+    }
+
+    // 以表中的事件创建订阅信息
+    SubscribeInfo subscribeInfo() const {
+        std::vector<const char *> events;
+        events.reserve(names_.size());
+        for (const auto &name : names_) {
+            events.push_back(name.c_str());
+        }
+        return SubscribeInfo(events.data(), static_cast<std::int32_t>(events.size()));
+    }
+
+    // 事件在表中的下标（即构造时的顺序），不在表中返回 npos
+    std::size_t slotOf(std::string_view event) const {
+        const std::uint64_t hash = Hash(event);
+        const std::uint32_t seed = seeds_[BucketOf(hash, seeds_.size())];
+        const std::uint32_t index = slots_[Mix(hash, seed) & mask_];
+        return index != kEmpty && names_[index] == event ? index : npos;
+    }
+
+    // 调用事件对应的处理函数，不在表中的事件返回 false
+    bool dispatch(const RcvData &data) const {
+        const char *event = data.event();
+        const std::size_t slot = event ? slotOf(event) : npos;
+        if (slot == npos) {
+            return false;
+        }
+        if (handlers_[slot]) {
+            handlers_[slot](data);
+        }
+        return true;
+    }
+
+    void operator()(const RcvData &data) const { dispatch(data); }
+
+    std::size_t size() const { return names_.size(); }
+    const std::string &name(std::size_t slot) const { return names_[slot]; }
+
+private:
+    static constexpr std::uint32_t kEmpty = UINT32_MAX;
+    static constexpr std::uint32_t kMaxSeed = 1u << 16;
+
+    // 按8字节一组哈希，高32位用来分桶，整个值再和种子混合后定位槽位
+    static std::uint64_t Hash(std::string_view key) {
+        std::uint64_t hash = 0x9E3779B97F4A7C15ull ^ key.size();
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= key.size(); i += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, key.data() + i, sizeof(word));
+            hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 32;
+        }
+        // 不足8字节的尾部：长度够时和前一组重叠读最后8字节，避免按字节拼
+        std::uint64_t tail = 0;
+        if (key.size() >= sizeof(tail)) {
+            std::memcpy(&tail, key.data() + key.size() - sizeof(tail), sizeof(tail));
+        } else {
+            for (; i < key.size(); ++i) {
+                tail = (tail << 8) | static_cast<unsigned char>(key[i]);
+            }
+        }
+        hash = (hash ^ tail) * 0xC4CEB9FE1A85EC53ull;
+        return hash ^ (hash >> 29);
+    }
+
+    // 用乘法代替取模把高32位映射到 [0, n)
+    static std::size_t BucketOf(std::uint64_t hash, std::size_t n) { return ((hash >> 32) * n) >> 32; }
+
+    static std::uint64_t Mix(std::uint64_t hash, std::uint32_t seed) {
+        return ((hash ^ seed) * 0x9E3779B97F4A7C15ull) >> 32;
+    }
+
+    // hash-and-displace：先按桶大小从大到小，为每个桶找一个让桶内事件都落到空槽位的种子
+    void build() {
+        const std::size_t count = names_.size();
+        std::vector<std::string_view> sorted(names_.begin(), names_.end());
+        std::sort(sorted.begin(), sorted.end());
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+            COMMON_THROW_ERROR(COMMONEVENT_ERR_INVALID_PARAMETER, "duplicate event in EventDispatcher");
+        }
+
+        std::vector<std::uint64_t> hashes(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            hashes[i] = Hash(names_[i]);
+        }
+        seeds_.assign(count > 0 ? count : 1, 0);
+        std::vector<std::vector<std::uint32_t>> buckets(seeds_.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            buckets[BucketOf(hashes[i], buckets.size())].push_back(static_cast<std::uint32_t>(i));
+        }
+        std::vector<std::size_t> order(buckets.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&buckets](std::size_t a, std::size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+        std::size_t tableSize = 1;
+        while (tableSize < count) {
+            tableSize <<= 1;
+        }
+        // 表太满找不到种子时把表扩大一倍重来
+        while (!place(buckets, order, hashes, tableSize)) {
+            tableSize <<= 1;
+        }
+    }
+
+    bool place(const std::vector<std::vector<std::uint32_t>> &buckets, const std::vector<std::size_t> &order,
+               const std::vector<std::uint64_t> &hashes, std::size_t tableSize) {
+        mask_ = tableSize - 1;
+        slots_.assign(tableSize, kEmpty);
+        std::vector<std::size_t> taken;
+        for (std::size_t bucket : order) {
+            const auto &keys = buckets[bucket];
+            if (keys.empty()) {
+                break;
+            }
+            std::uint32_t seed = 0;
+            for (; seed < kMaxSeed; ++seed) {
+                taken.clear();
+                for (std::uint32_t key : keys) {
+                    const std::size_t slot = Mix(hashes[key], seed) & mask_;
+                    if (slots_[slot] != kEmpty || std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+                        break;
+                    }
+                    taken.push_back(slot);
+                }
+                if (taken.size() == keys.size()) {
+                    break;
+                }
+            }
+            if (seed == kMaxSeed) {
+                return false;
+            }
+            seeds_[bucket] = seed;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                slots_[taken[i]] = keys[i];
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::string> names_;
+    std::vector<Handler> handlers_;
+    std::vector<std::uint32_t> seeds_; // 每个桶的种子
+    std::vector<std::uint32_t> slots_; // 槽位到事件下标
+    std::size_t mask_ = 0;
 };
 
 #if OHOS_API_VERSION >= 18
@@ -280,10 +814,26 @@ private:
     info_type *info_;
 };
 
-static inline void Publish(const char *event) { COMMON_CHECK_ERROR_INLINE_DEFAULT(OH_CommonEvent_Publish(event)); }
+// 发布的次数和调用耗时计入 SnapshotEventMetrics
+static inline void Publish(const char *event) {
+    COMMON_CHECK_ERROR(detail::TimedPublish(event, [event] { return OH_CommonEvent_Publish(event); }),
+                       "OH_CommonEvent_Publish(event)");
+}
 
 static inline void Publish(const char *event, const PublishInfo &info) {
-    COMMON_CHECK_ERROR_INLINE_DEFAULT(OH_CommonEvent_PublishWithInfo(event, info.info()));
+    COMMON_CHECK_ERROR(
+        detail::TimedPublish(event, [event, &info] { return OH_CommonEvent_PublishWithInfo(event, info.info()); }),
+        "OH_CommonEvent_PublishWithInfo(event, info.info())");
+}
+
+// 不抛异常的版本，失败时返回错误码
+static inline common::Expected<void> TryPublish(const char *event) {
+    return ToExpected(detail::TimedPublish(event, [event] { return OH_CommonEvent_Publish(event); }));
+}
+
+static inline common::Expected<void> TryPublish(const char *event, const PublishInfo &info) {
+    return ToExpected(
+        detail::TimedPublish(event, [event, &info] { return OH_CommonEvent_PublishWithInfo(event, info.info()); }));
 }
 
 static inline bool IsOrderedCommonEvent(const Subscriber &subscriber) {
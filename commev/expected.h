@@ -0,0 +1,133 @@
+#ifndef COMMON_EXPECTED_H
+#define COMMON_EXPECTED_H
+
+#include <cstdlib>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#if __has_include(<expected>)
+# include <expected>
+#endif
+
+namespace OHOS {
+namespace common {
+
+/**
+ * @brief 不抛异常的接口的返回值：成功时带结果，失败时带 std::error_code
+ * @note 有 std::expected 时直接使用；否则用下面接口相同的精简实现。
+ *       对失败的结果调用 value() 时抛出异常，关闭异常时直接终止进程
+ */
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+
+template <typename T, typename E = std::error_code> using Expected = std::expected<T, E>;
+template <typename E> using Unexpected = std::unexpected<E>;
+
+#else
+
+template <typename E> class Unexpected {
+public:
+    constexpr explicit Unexpected(E error) : error_(std::move(error)) {}
+
+    constexpr const E &error() const & { return error_; }
+    constexpr E &error() & { return error_; }
+
+private:
+    E error_;
+};
+
+template <typename E> Unexpected(E) -> Unexpected<E>;
+
+namespace detail {
+
+template <typename E> [[noreturn]] inline void BadExpectedAccess(const E &error) {
+#if defined(__cpp_exceptions)
+    if constexpr (std::is_same_v<E, std::error_code>) {
+        throw std::system_error(error, "bad expected access");
+    } else {
+        throw error;
+    }
+#else
+    (void)error;
+    std::abort();
+#endif
+}
+
+} // namespace detail
+
+template <typename T, typename E = std::error_code> class Expected {
+public:
+    using value_type = T;
+    using error_type = E;
+
+    template <typename U = T, typename = std::enable_if_t<std::is_default_constructible_v<U>>>
+    constexpr Expected() : storage_(std::in_place_index<0>) {}
+    constexpr Expected(const T &value) : storage_(std::in_place_index<0>, value) {}
+    constexpr Expected(T &&value) : storage_(std::in_place_index<0>, std::move(value)) {}
+    template <typename G> constexpr Expected(const Unexpected<G> &error) : storage_(std::in_place_index<1>, error.error()) {}
+
+    constexpr bool has_value() const noexcept { return storage_.index() == 0; }
+    constexpr explicit operator bool() const noexcept { return has_value(); }
+
+    constexpr T &value() & {
+        if (!has_value()) {
+            detail::BadExpectedAccess(error());
+        }
+        return *std::get_if<0>(&storage_);
+    }
+    constexpr const T &value() const & {
+        if (!has_value()) {
+            detail::BadExpectedAccess(error());
+        }
+        return *std::get_if<0>(&storage_);
+    }
+    constexpr T &&value() && { return std::move(value()); }
+
+    template <typename U> constexpr T value_or(U &&fallback) const & {
+        return has_value() ? **this : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    constexpr const E &error() const & { return *std::get_if<1>(&storage_); }
+    constexpr E &error() & { return *std::get_if<1>(&storage_); }
+
+    constexpr T &operator*() & { return *std::get_if<0>(&storage_); }
+    constexpr const T &operator*() const & { return *std::get_if<0>(&storage_); }
+    constexpr T &&operator*() && { return std::move(*std::get_if<0>(&storage_)); }
+    constexpr T *operator->() { return std::get_if<0>(&storage_); }
+    constexpr const T *operator->() const { return std::get_if<0>(&storage_); }
+
+private:
+    std::variant<T, E> storage_;
+};
+
+template <typename E> class Expected<void, E> {
+public:
+    using value_type = void;
+    using error_type = E;
+
+    constexpr Expected() = default;
+    template <typename G> constexpr Expected(const Unexpected<G> &error) : error_(error.error()), ok_(false) {}
+
+    constexpr bool has_value() const noexcept { return ok_; }
+    constexpr explicit operator bool() const noexcept { return ok_; }
+
+    constexpr void value() const {
+        if (!ok_) {
+            detail::BadExpectedAccess(error_);
+        }
+    }
+
+    constexpr const E &error() const & { return error_; }
+    constexpr E &error() & { return error_; }
+
+private:
+    E error_{};
+    bool ok_ = true;
+};
+
+#endif
+
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMON_EXPECTED_H
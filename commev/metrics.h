@@ -0,0 +1,348 @@
+#ifndef COMMONEV_METRICS_H
+#define COMMONEV_METRICS_H
+
+#include <BasicServicesKit/oh_commonevent.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * 事件分发的内置统计：按事件名统计收到的次数、处理函数耗时、发布次数和发布调用耗时。
+ * 统计项的指针按订阅者（发布时按线程）缓存，热路径上只有一次事件名比较、两次取时钟和几次 relaxed 原子加；
+ * 编译时定义 COMMEV_METRICS=0 可以整个去掉，此时 SnapshotEventMetrics 返回空表。
+ * 整个程序中各编译单元的 COMMEV_METRICS 要一致
+ */
+#ifndef COMMEV_METRICS
+# define COMMEV_METRICS 1
+#endif
+
+// 分别统计的事件名个数上限，须为 2 的幂；超出的事件，以及表快满时探测不到空位的事件合并记在 "<other>" 下
+#ifndef COMMEV_METRICS_MAX_EVENTS
+# define COMMEV_METRICS_MAX_EVENTS 128
+#endif
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+/**
+ * @brief 耗时直方图，按纳秒记录
+ * @note HDR 式的对数-线性分桶：每个 2 的幂区间再等分 kSubBuckets 份，相对误差不超过 1/kSubBuckets；
+ *       记录只是对所在的桶做一次原子加，不加锁
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBits = 3;
+    static constexpr std::size_t kSubBuckets = std::size_t(1) << kSubBits;
+    static constexpr unsigned kMaxBits = 40; // 约 18 分钟，更长的记在最后一个桶里
+    static constexpr std::size_t kBuckets = (kMaxBits - kSubBits + 1) * kSubBuckets;
+
+    static std::size_t BucketOf(std::uint64_t ns) {
+        if (ns < kSubBuckets) {
+            return static_cast<std::size_t>(ns);
+        }
+        const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(ns));
+        if (msb >= kMaxBits) {
+            return kBuckets - 1;
+        }
+        const unsigned shift = msb - kSubBits;
+        return (shift + 1) * kSubBuckets + static_cast<std::size_t>((ns >> shift) & (kSubBuckets - 1));
+    }
+
+    // 桶内的最小值和最大值
+    static std::uint64_t LowerBound(std::size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        const unsigned shift = static_cast<unsigned>(bucket / kSubBuckets) - 1;
+        return (kSubBuckets + bucket % kSubBuckets) << shift;
+    }
+    static std::uint64_t UpperBound(std::size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        const unsigned shift = static_cast<unsigned>(bucket / kSubBuckets) - 1;
+        return LowerBound(bucket) + (std::uint64_t(1) << shift) - 1;
+    }
+
+    void record(std::uint64_t ns) {
+        buckets_[BucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        std::uint64_t max = max_.load(std::memory_order_relaxed);
+        while (ns > max && !max_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    // 各桶分别读取，并发记录时 count 与 sum 可能相差正在进行的几次；reset 时读后清零
+    template <typename Snapshot> void collect(Snapshot &out, bool reset) {
+        out.buckets.assign(kBuckets, 0);
+        out.count = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            out.buckets[i] = reset ? buckets_[i].exchange(0, std::memory_order_relaxed)
+                                   : buckets_[i].load(std::memory_order_relaxed);
+            out.count += out.buckets[i];
+        }
+        out.sum = reset ? sum_.exchange(0, std::memory_order_relaxed) : sum_.load(std::memory_order_relaxed);
+        out.max = reset ? max_.exchange(0, std::memory_order_relaxed) : max_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+struct LatencySnapshot {
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0; // 纳秒
+    std::uint64_t max = 0; // 纳秒
+    std::vector<std::uint64_t> buckets; // 下标同 LatencyHistogram::BucketOf
+
+    double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+
+    // q 取 [0, 1]，返回所在桶的上界（不超过 max），没有记录时返回 0
+    std::uint64_t quantile(double q) const {
+        if (count == 0) {
+            return 0;
+        }
+        const double clamped = std::min(std::max(q, 0.0), 1.0);
+        const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(clamped * count + 0.5));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return std::min(LatencyHistogram::UpperBound(i), max);
+            }
+        }
+        return max;
+    }
+};
+
+struct EventMetrics {
+    std::string event;
+    std::uint64_t received = 0;      // 带闭包订阅者收到的次数，同一事件有多个订阅者时各算一次
+    std::uint64_t published = 0;     // Publish/TryPublish 成功的次数
+    std::uint64_t publishFailed = 0; // Publish/TryPublish 失败的次数
+    LatencySnapshot handler;         // 处理函数耗时
+    LatencySnapshot publish;         // 发布调用耗时，含失败的调用
+};
+
+namespace detail {
+
+using MetricsClock = std::chrono::steady_clock;
+
+inline std::uint64_t ElapsedNs(MetricsClock::time_point start) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(MetricsClock::now() - start).count());
+}
+
+#if COMMEV_METRICS
+
+struct EventStats {
+    explicit EventStats(std::string event) : name(std::move(event)) {}
+
+    const std::string name;
+    std::atomic<std::uint64_t> received{0};
+    std::atomic<std::uint64_t> published{0};
+    std::atomic<std::uint64_t> publishFailed{0};
+    LatencyHistogram handler;
+    LatencyHistogram publish;
+};
+
+/**
+ * @brief 事件名到统计项的开放寻址表
+ * @note 统计项在第一次遇到该事件名时创建，用 CAS 插入，之后一直保留；查找不加锁。
+ *       最多探测 kMaxProbe 个槽位，表满时未登记的事件也不用扫完整张表
+ */
+class EventMetricsRegistry {
+public:
+    static constexpr std::size_t kCapacity = COMMEV_METRICS_MAX_EVENTS;
+    static constexpr std::size_t kMaxProbe = kCapacity < 16 ? kCapacity : 16;
+    static_assert(kCapacity && (kCapacity & (kCapacity - 1)) == 0, "COMMEV_METRICS_MAX_EVENTS must be a power of two");
+
+    // 回调线程在进程退出时可能还在记录，不析构
+    static EventMetricsRegistry &Instance() {
+        static EventMetricsRegistry *registry = new EventMetricsRegistry();
+        return *registry;
+    }
+
+    EventStats &find(const char *event) {
+        const std::size_t length = std::strlen(event);
+        std::uint64_t hash = 14695981039346656037ull; // FNV-1a
+        for (std::size_t i = 0; i < length; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(event[i])) * 1099511628211ull;
+        }
+        for (std::size_t probe = 0; probe < kMaxProbe; ++probe) {
+            auto &slot = slots_[(hash + probe) & (kCapacity - 1)];
+            EventStats *stats = slot.load(std::memory_order_acquire);
+            if (!stats) {
+                auto *created = new EventStats(std::string(event, length));
+                if (slot.compare_exchange_strong(stats, created, std::memory_order_acq_rel)) {
+                    return *created;
+                }
+                delete created; // 别的线程抢先插入，stats 为插入的项
+            }
+            if (stats->name.size() == length && std::memcmp(stats->name.data(), event, length) == 0) {
+                return *stats;
+            }
+        }
+        return overflow_;
+    }
+
+    bool isOverflow(const EventStats &stats) const { return &stats == &overflow_; }
+
+    std::vector<EventMetrics> snapshot(bool reset) {
+        std::vector<EventMetrics> result;
+        for (auto &slot : slots_) {
+            if (EventStats *stats = slot.load(std::memory_order_acquire)) {
+                collect(*stats, reset, result.emplace_back());
+            }
+        }
+        EventMetrics other;
+        collect(overflow_, reset, other);
+        if (other.received || other.published || other.publishFailed) {
+            result.push_back(std::move(other));
+        }
+        std::sort(result.begin(), result.end(),
+                  [](const EventMetrics &lhs, const EventMetrics &rhs) { return lhs.event < rhs.event; });
+        return result;
+    }
+
+private:
+    EventMetricsRegistry() = default;
+
+    static std::uint64_t Take(std::atomic<std::uint64_t> &counter, bool reset) {
+        return reset ? counter.exchange(0, std::memory_order_relaxed) : counter.load(std::memory_order_relaxed);
+    }
+
+    static void collect(EventStats &stats, bool reset, EventMetrics &out) {
+        out.event = stats.name;
+        out.received = Take(stats.received, reset);
+        out.published = Take(stats.published, reset);
+        out.publishFailed = Take(stats.publishFailed, reset);
+        stats.handler.collect(out.handler, reset);
+        stats.publish.collect(out.publish, reset);
+    }
+
+    std::array<std::atomic<EventStats *>, kCapacity> slots_{};
+    EventStats overflow_{"<other>"};
+};
+
+/**
+ * @brief 最近用到的几个统计项的指针，命中时只比较一次事件名，不再计算哈希和探测表
+ * @note 可以被多个线程同时使用，并发填写时最多多查几次表；统计项不会释放，缓存的指针一直有效
+ */
+class EventStatsCache {
+public:
+    static constexpr std::size_t kEntries = 4;
+
+    EventStats &find(const char *event) {
+        for (auto &entry : entries_) {
+            EventStats *stats = entry.load(std::memory_order_acquire);
+            if (!stats) {
+                break;
+            }
+            if (std::strcmp(stats->name.c_str(), event) == 0) {
+                return *stats;
+            }
+        }
+        auto &registry = EventMetricsRegistry::Instance();
+        EventStats &stats = registry.find(event);
+        // 合并记录的项按名字比较不出来，不缓存
+        if (!registry.isOverflow(stats)) {
+            entries_[next_.fetch_add(1, std::memory_order_relaxed) % kEntries].store(&stats,
+                                                                                     std::memory_order_release);
+        }
+        return stats;
+    }
+
+    void clear() {
+        for (auto &entry : entries_) {
+            entry.store(nullptr, std::memory_order_relaxed);
+        }
+        next_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<EventStats *>, kEntries> entries_{}; // 按填写顺序，空位只在末尾
+    std::atomic<unsigned> next_{0};
+};
+
+#else
+
+class EventStatsCache {
+public:
+    void clear() {}
+};
+
+#endif // COMMEV_METRICS
+
+// 记录一次处理函数的执行，析构时计时，处理函数抛出异常也会记录；cache 为订阅者自己的缓存
+class HandlerTimer {
+public:
+#if COMMEV_METRICS
+    HandlerTimer(const CommonEvent_RcvData *data, EventStatsCache &cache)
+        : data_(data), cache_(cache), start_(MetricsClock::now()) {}
+    ~HandlerTimer() {
+        const char *event = OH_CommonEvent_GetEventFromRcvData(data_);
+        if (!event) {
+            return;
+        }
+        EventStats &stats = cache_.find(event);
+        stats.received.fetch_add(1, std::memory_order_relaxed);
+        stats.handler.record(ElapsedNs(start_));
+    }
+
+private:
+    const CommonEvent_RcvData *data_;
+    EventStatsCache &cache_;
+    MetricsClock::time_point start_;
+#else
+    HandlerTimer(const CommonEvent_RcvData *, EventStatsCache &) {}
+#endif
+};
+
+// 执行一次发布调用 fn 并记录耗时与结果
+template <typename Fn> CommonEvent_ErrCode TimedPublish(const char *event, Fn &&fn) {
+#if COMMEV_METRICS
+    const auto start = MetricsClock::now();
+    const CommonEvent_ErrCode code = fn();
+    if (event) {
+        // 发布线程通常反复发布少数几个事件，按线程缓存
+        thread_local EventStatsCache cache;
+        EventStats &stats = cache.find(event);
+        (code == COMMONEVENT_ERR_OK ? stats.published : stats.publishFailed).fetch_add(1, std::memory_order_relaxed);
+        stats.publish.record(ElapsedNs(start));
+    }
+    return code;
+#else
+    (void)event;
+    return fn();
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief 取各事件当前的统计，按事件名排序；reset 为 true 时读后清零，用于定期输出区间内的统计
+ * @note 各计数分别读取，不是同一时刻的快照，并发记录时相互之间可能相差几次
+ */
+inline std::vector<EventMetrics> SnapshotEventMetrics(bool reset = false) {
+#if COMMEV_METRICS
+    return detail::EventMetricsRegistry::Instance().snapshot(reset);
+#else
+    (void)reset;
+    return {};
+#endif
+}
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_METRICS_H
@@ -0,0 +1,301 @@
+#ifndef COMMONEV_ORDERED_H
+#define COMMONEV_ORDERED_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "event.h"
+
+#if OHOS_API_VERSION >= 18
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+// 令牌到期时的处理方式
+enum class OrderedTimeout {
+    Finish, // 直接结束，事件继续传给后面的订阅者
+    Abort,  // 终止后再结束，后面的订阅者不再收到
+};
+
+struct OrderedOptions {
+    std::chrono::milliseconds deadline{1000}; // 从取得令牌起最多占用有序事件的时间
+    OrderedTimeout onTimeout = OrderedTimeout::Finish;
+};
+
+struct OrderedMetrics {
+    std::uint64_t taken = 0;    // 取得的令牌数
+    std::uint64_t finished = 0; // 由处理方正常结束的数量
+    std::uint64_t aborted = 0;  // 由处理方终止的数量
+    std::uint64_t expired = 0;  // 到期后自动结束的数量
+    std::uint64_t active = 0;   // 还没结束的令牌数
+    std::chrono::nanoseconds totalHold{0}; // 从取得令牌到结束的总时长，即拖住有序事件的时间
+    std::chrono::nanoseconds maxHold{0};
+};
+
+namespace detail {
+
+class OrderedCore;
+
+struct OrderedState {
+    using Clock = std::chrono::steady_clock;
+
+    std::mutex mutex; // 同一个有序事件上的 NDK 调用串行执行
+    CommonEvent_Subscriber *subscriber = nullptr;
+    bool done = false;
+    Clock::time_point taken;
+    OrderedTimeout onTimeout = OrderedTimeout::Finish;
+    std::shared_ptr<OrderedCore> core;
+};
+
+class OrderedCore {
+public:
+    using Clock = OrderedState::Clock;
+
+    enum class Outcome { Finished, Aborted, Expired };
+
+    // 结束有序事件并记账，已经结束时返回 false
+    bool complete(OrderedState &state, Outcome outcome) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.done) {
+            return false;
+        }
+        if (outcome == Outcome::Aborted ||
+            (outcome == Outcome::Expired && state.onTimeout == OrderedTimeout::Abort)) {
+            OH_CommonEvent_AbortCommonEvent(state.subscriber);
+        }
+        OH_CommonEvent_FinishCommonEvent(state.subscriber);
+        state.done = true;
+        const auto hold = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - state.taken);
+        std::lock_guard<std::mutex> metricsLock(mutex_);
+        switch (outcome) {
+        case Outcome::Finished:
+            ++metrics_.finished;
+            break;
+        case Outcome::Aborted:
+            ++metrics_.aborted;
+            break;
+        case Outcome::Expired:
+            ++metrics_.expired;
+            break;
+        }
+        --metrics_.active;
+        metrics_.totalHold += hold;
+        if (hold > metrics_.maxHold) {
+            metrics_.maxHold = hold;
+        }
+        return true;
+    }
+
+    void track(const std::shared_ptr<OrderedState> &state, Clock::time_point deadline) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++metrics_.taken;
+        ++metrics_.active;
+        timers_.push(Timer{deadline, state});
+        if (!timer_.joinable()) {
+            timer_ = std::thread(&OrderedCore::runTimer, this);
+        }
+        wakeup_.notify_one();
+    }
+
+    // 停止计时线程，还没结束的令牌按到期处理
+    void stop() {
+        std::vector<std::shared_ptr<OrderedState>> pending;
+        std::thread timer;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (!timers_.empty()) {
+                if (auto state = timers_.top().state.lock()) {
+                    pending.push_back(std::move(state));
+                }
+                timers_.pop();
+            }
+            stopping_ = true;
+            timer.swap(timer_);
+        }
+        wakeup_.notify_one();
+        if (timer.joinable()) {
+            timer.join();
+        }
+        for (const auto &state : pending) {
+            complete(*state, Outcome::Expired);
+        }
+    }
+
+    OrderedMetrics metrics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return metrics_;
+    }
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        std::weak_ptr<OrderedState> state; // 令牌析构时已经结束，不必再保留
+        bool operator>(const Timer &other) const { return deadline > other.deadline; }
+    };
+
+    void runTimer() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            if (timers_.empty()) {
+                wakeup_.wait(lock);
+                continue;
+            }
+            const Clock::time_point deadline = timers_.top().deadline;
+            if (Clock::now() < deadline) {
+                wakeup_.wait_until(lock, deadline);
+                continue;
+            }
+            std::shared_ptr<OrderedState> state = timers_.top().state.lock();
+            timers_.pop();
+            if (!state) {
+                continue;
+            }
+            lock.unlock();
+            complete(*state, Outcome::Expired);
+            lock.lock();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    OrderedMetrics metrics_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    std::condition_variable wakeup_;
+    std::thread timer_; // 第一次取得令牌时才启动
+    bool stopping_ = false;
+};
+
+} // namespace detail
+
+/**
+ * @brief 有序事件的令牌：回调里取得后可以把事件带到别的线程处理，再在任意线程上结束、终止或改写结果
+ * @note 各操作在同一令牌上串行执行；结束后再调用一律返回 false。
+ *       析构时还没结束则直接结束；令牌要在对应的 Subscriber 析构前结束
+ */
+class OrderedToken {
+public:
+    OrderedToken() = default;
+    OrderedToken(const OrderedToken &) = delete;
+    OrderedToken &operator=(const OrderedToken &) = delete;
+    OrderedToken(OrderedToken &&other) noexcept = default;
+    OrderedToken &operator=(OrderedToken &&other) noexcept {
+        if (this != &other) {
+            finish();
+            state_ = std::move(other.state_);
+        }
+        return *this;
+    }
+    ~OrderedToken() { finish(); }
+
+    // 收到的不是有序事件时令牌无效，各操作都返回 false
+    bool valid() const { return state_ != nullptr; }
+    explicit operator bool() const { return valid(); }
+
+    bool done() const {
+        if (!state_) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->done;
+    }
+
+    bool setCode(std::int32_t code) {
+        return apply([code](CommonEvent_Subscriber *subscriber) {
+            return OH_CommonEvent_SetCodeToSubscriber(subscriber, code);
+        });
+    }
+
+    bool setData(std::string_view data) {
+        return apply([data](CommonEvent_Subscriber *subscriber) {
+            return OH_CommonEvent_SetDataToSubscriber(subscriber, data.data(), data.size());
+        });
+    }
+
+    // 取当前的 code，令牌无效或已结束时返回 defaultValue
+    std::int32_t code(std::int32_t defaultValue = 0) const {
+        std::int32_t result = defaultValue;
+        apply([&result](CommonEvent_Subscriber *subscriber) {
+            result = OH_CommonEvent_GetCodeFromSubscriber(subscriber);
+            return true;
+        });
+        return result;
+    }
+
+    bool clearAbort() {
+        return apply([](CommonEvent_Subscriber *subscriber) { return OH_CommonEvent_ClearAbortCommonEvent(subscriber); });
+    }
+
+    // 结束，事件传给后面的订阅者
+    bool finish() { return state_ && state_->core->complete(*state_, detail::OrderedCore::Outcome::Finished); }
+
+    // 终止后结束，后面的订阅者不再收到
+    bool abort() { return state_ && state_->core->complete(*state_, detail::OrderedCore::Outcome::Aborted); }
+
+private:
+    friend class OrderedEventTracker;
+    explicit OrderedToken(std::shared_ptr<detail::OrderedState> state) : state_(std::move(state)) {}
+
+    template <typename Fn> bool apply(Fn &&fn) const {
+        if (!state_) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return !state_->done && fn(state_->subscriber);
+    }
+
+    std::shared_ptr<detail::OrderedState> state_;
+};
+
+/**
+ * @brief 发放有序事件的令牌，到期没结束的由一个计时线程自动结束，并统计占用有序事件的时长
+ * @note 析构时还没结束的令牌按到期处理
+ */
+class OrderedEventTracker {
+public:
+    explicit OrderedEventTracker(OrderedOptions options = OrderedOptions())
+        : options_(options), core_(std::make_shared<detail::OrderedCore>()) {}
+
+    OrderedEventTracker(const OrderedEventTracker &) = delete;
+    OrderedEventTracker &operator=(const OrderedEventTracker &) = delete;
+
+    ~OrderedEventTracker() { core_->stop(); }
+
+    // 在回调线程上调用，subscriber 为回调的第二个参数
+    OrderedToken take(CommonEvent_Subscriber *subscriber) { return take(subscriber, options_.deadline); }
+
+    OrderedToken take(CommonEvent_Subscriber *subscriber, std::chrono::milliseconds deadline) {
+        if (!subscriber || !OH_CommonEvent_IsOrderedCommonEvent(subscriber)) {
+            return OrderedToken();
+        }
+        auto state = std::make_shared<detail::OrderedState>();
+        state->subscriber = subscriber;
+        state->taken = detail::OrderedState::Clock::now();
+        state->onTimeout = options_.onTimeout;
+        state->core = core_;
+        core_->track(state, state->taken + deadline);
+        return OrderedToken(std::move(state));
+    }
+
+    OrderedMetrics metrics() const { return core_->metrics(); }
+
+private:
+    OrderedOptions options_;
+    std::shared_ptr<detail::OrderedCore> core_;
+};
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif
+
+#endif // COMMONEV_ORDERED_H
@@ -0,0 +1,422 @@
+#ifndef COMMONEV_POOL_H
+#define COMMONEV_POOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "event.h"
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+#if OHOS_API_VERSION >= 18
+
+/**
+ * @brief 可复用的 PublishInfo 和 Parameters，用于高频发布同一类事件
+ * @note 池中的对象记录了上次写入原生对象的内容，本次设置的值没有变化时不再调用 NDK 接口。
+ *       一次发布中没有设置的字段会恢复为默认值：code/data 直接覆盖，
+ *       bundleName/permissions 和多余的参数键没有清除接口，只能重建对应的原生对象。
+ *       池本身是线程安全的，同一个 Lease 只能在一个线程中使用
+ */
+class PublishPool {
+    struct Field {
+        std::string key;
+        ParamType type;
+        std::string bytes;          // 上次写入的值的原始字节
+        std::uint64_t touched = 0;  // 最近一次设置它的发布批次
+    };
+
+    struct Entry {
+        explicit Entry(bool ordered) : ordered(ordered), info(ordered) {}
+
+        bool ordered;
+        PublishInfo info;
+        Parameters params;
+        bool attached = false; // params 是否已经挂到 info 上
+
+        std::int32_t code = 0;
+        std::string data;
+        std::string bundleName;
+        std::vector<std::string> permissions;
+
+        std::vector<Field> fields;
+        std::size_t cursor = 0; // 下一个参数最可能的下标
+        std::uint64_t generation = 1;
+        bool codeTouched = false;
+        bool dataTouched = false;
+        bool bundleTouched = false;
+        bool permissionsTouched = false;
+
+        std::uint64_t written = 0;
+        std::uint64_t skipped = 0;
+    };
+
+public:
+    struct Stats {
+        std::uint64_t created = 0; // 新建的原生对象组数
+        std::uint64_t reused = 0;  // 从池中取出复用的次数
+        std::uint64_t written = 0; // 调用 NDK 写入的字段数
+        std::uint64_t skipped = 0; // 值没变而省掉的写入数
+    };
+
+    // 借出的发布对象，析构时归还到池中；一次借出可以连续发布多次
+    class Lease {
+    public:
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+        Lease(Lease &&other) noexcept : pool_(std::exchange(other.pool_, nullptr)), entry_(std::move(other.entry_)) {}
+        Lease &operator=(Lease &&other) noexcept {
+            if (this != &other) {
+                reset();
+                pool_ = std::exchange(other.pool_, nullptr);
+                entry_ = std::move(other.entry_);
+            }
+            return *this;
+        }
+        ~Lease() { reset(); }
+
+        void setCode(std::int32_t code) {
+            entry_->codeTouched = true;
+            if (code == entry_->code) {
+                ++entry_->skipped;
+                return;
+            }
+            entry_->info.setCode(code);
+            entry_->code = code;
+            ++entry_->written;
+        }
+        void setData(std::string_view data) {
+            entry_->dataTouched = true;
+            if (data == entry_->data) {
+                ++entry_->skipped;
+                return;
+            }
+            entry_->info.setData(data.data(), data.size());
+            entry_->data.assign(data.data(), data.size());
+            ++entry_->written;
+        }
+        void setBundleName(std::string_view bundleName) {
+            entry_->bundleTouched = true;
+            if (bundleName == entry_->bundleName) {
+                ++entry_->skipped;
+                return;
+            }
+            entry_->bundleName.assign(bundleName.data(), bundleName.size());
+            entry_->info.setBunduleName(entry_->bundleName.c_str());
+            ++entry_->written;
+        }
+        void setPermissions(const std::vector<std::string> &permissions) {
+            entry_->permissionsTouched = true;
+            if (permissions == entry_->permissions) {
+                ++entry_->skipped;
+                return;
+            }
+            entry_->permissions = permissions;
+            ApplyPermissions(*entry_);
+            ++entry_->written;
+        }
+
+        void setInt(const char *key, int value) { set(key, ParamType::Int, &value, sizeof(value)); }
+        void setLong(const char *key, long value) { set(key, ParamType::Long, &value, sizeof(value)); }
+        void setBool(const char *key, bool value) { set(key, ParamType::Bool, &value, sizeof(value)); }
+        void setChar(const char *key, char value) { set(key, ParamType::Char, &value, sizeof(value)); }
+        void setDouble(const char *key, double value) { set(key, ParamType::Double, &value, sizeof(value)); }
+
+        void setIntArray(const char *key, const int *value, std::size_t num) {
+            set(key, ParamType::IntArray, value, num * sizeof(int));
+        }
+        void setIntArray(const char *key, const std::vector<int> &value) {
+            setIntArray(key, value.data(), value.size());
+        }
+        void setLongArray(const char *key, const long *value, std::size_t num) {
+            set(key, ParamType::LongArray, value, num * sizeof(long));
+        }
+        void setLongArray(const char *key, const std::vector<long> &value) {
+            setLongArray(key, value.data(), value.size());
+        }
+        void setBoolArray(const char *key, const bool *value, std::size_t num) {
+            set(key, ParamType::BoolArray, value, num * sizeof(bool));
+        }
+        void setCharArray(const char *key, std::string_view value) {
+            set(key, ParamType::CharArray, value.data(), value.size());
+        }
+        void setCharArray(const char *key, const char *value, std::size_t num) {
+            set(key, ParamType::CharArray, value, num);
+        }
+        void setDoubleArray(const char *key, const double *value, std::size_t num) {
+            set(key, ParamType::DoubleArray, value, num * sizeof(double));
+        }
+        void setDoubleArray(const char *key, const std::vector<double> &value) {
+            setDoubleArray(key, value.data(), value.size());
+        }
+
+        /**
+         * @brief 发布事件，本批次没有设置的字段先恢复为默认值
+         * @note 发布之后开始新的批次，下一次发布前需要重新设置要带的字段
+         */
+        void publish(const char *event) {
+            prepare();
+            Publish(event, entry_->info);
+            finish();
+        }
+
+        // 不抛异常的版本，发布失败时返回错误码，本批次设置的字段留到下一次发布
+        common::Expected<void> tryPublish(const char *event) {
+            prepare();
+            auto result = TryPublish(event, entry_->info);
+            if (result) {
+                finish();
+            }
+            return result;
+        }
+
+        const PublishInfo &info() const { return entry_->info; }
+        const Parameters &parameters() const { return entry_->params; }
+
+    private:
+        // 把本批次没有设置的字段恢复为默认值
+        void prepare() {
+            Entry &entry = *entry_;
+            if (!entry.codeTouched && entry.code != 0) {
+                entry.info.setCode(0);
+                entry.code = 0;
+                ++entry.written;
+            }
+            if (!entry.dataTouched && !entry.data.empty()) {
+                entry.info.setData("", 0);
+                entry.data.clear();
+                ++entry.written;
+            }
+            if ((!entry.bundleTouched && !entry.bundleName.empty()) ||
+                (!entry.permissionsTouched && !entry.permissions.empty())) {
+                RebuildInfo(entry);
+            }
+            bool stale = false;
+            for (const Field &field : entry.fields) {
+                stale = stale || field.touched != entry.generation;
+            }
+            if (stale) {
+                RebuildParameters(entry);
+            }
+            if (!entry.attached) {
+                entry.info.setParameters(entry.params);
+                entry.attached = true;
+            }
+        }
+
+        // 发布成功后开始新的批次
+        void finish() {
+            Entry &entry = *entry_;
+            ++entry.generation;
+            entry.cursor = 0;
+            entry.codeTouched = entry.dataTouched = entry.bundleTouched = entry.permissionsTouched = false;
+        }
+
+        friend class PublishPool;
+        Lease(PublishPool *pool, std::unique_ptr<Entry> entry) : pool_(pool), entry_(std::move(entry)) {}
+
+        void reset() {
+            if (pool_ && entry_) {
+                pool_->release(std::move(entry_));
+            }
+            pool_ = nullptr;
+        }
+
+        void set(const char *key, ParamType type, const void *value, std::size_t size) {
+            Entry &entry = *entry_;
+            // 每次发布通常按相同的顺序设置参数，先看上次位置的下一个
+            Field *field = nullptr;
+            const std::size_t count = entry.fields.size();
+            for (std::size_t i = 0; i < count; ++i) {
+                std::size_t index = entry.cursor + i;
+                index = index < count ? index : index - count;
+                if (entry.fields[index].key == key) {
+                    field = &entry.fields[index];
+                    entry.cursor = index + 1 < count ? index + 1 : 0;
+                    break;
+                }
+            }
+            if (field && field->type == type && field->bytes.size() == size &&
+                (size == 0 || std::memcmp(field->bytes.data(), value, size) == 0)) {
+                field->touched = entry.generation;
+                ++entry.skipped;
+                return;
+            }
+            ApplyField(entry.params, key, type, static_cast<const char *>(value), size);
+            if (!field) {
+                field = &entry.fields.emplace_back();
+                field->key = key;
+            }
+            field->type = type;
+            field->bytes.assign(static_cast<const char *>(value), size);
+            field->touched = entry.generation;
+            ++entry.written;
+        }
+
+        PublishPool *pool_;
+        std::unique_ptr<Entry> entry_;
+    };
+
+    explicit PublishPool(std::size_t maxIdle = 8) : maxIdle_(maxIdle) {}
+    PublishPool(const PublishPool &) = delete;
+    PublishPool &operator=(const PublishPool &) = delete;
+
+    // 借出一组发布对象，池中没有空闲的就新建一组
+    Lease acquire(bool ordered = false) {
+        std::unique_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &idle = idle_[ordered];
+            if (!idle.empty()) {
+                entry = std::move(idle.back());
+                idle.pop_back();
+            }
+        }
+        if (entry) {
+            reused_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            entry.reset(new Entry(ordered));
+            created_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return Lease(this, std::move(entry));
+    }
+
+    Stats stats() const {
+        Stats stats;
+        stats.created = created_.load(std::memory_order_relaxed);
+        stats.reused = reused_.load(std::memory_order_relaxed);
+        stats.written = written_.load(std::memory_order_relaxed);
+        stats.skipped = skipped_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    void release(std::unique_ptr<Entry> entry) {
+        written_.fetch_add(std::exchange(entry->written, 0), std::memory_order_relaxed);
+        skipped_.fetch_add(std::exchange(entry->skipped, 0), std::memory_order_relaxed);
+        // 归还前设置了却没发布的字段，下次借出时按未设置处理
+        ++entry->generation;
+        entry->cursor = 0;
+        entry->codeTouched = entry->dataTouched = entry->bundleTouched = entry->permissionsTouched = false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &idle = idle_[entry->ordered];
+        if (idle.size() < maxIdle_) {
+            idle.push_back(std::move(entry));
+        }
+    }
+
+    static void ApplyPermissions(Entry &entry) {
+        std::vector<const char *> permissions;
+        permissions.reserve(entry.permissions.size());
+        for (const auto &permission : entry.permissions) {
+            permissions.push_back(permission.c_str());
+        }
+        entry.info.setPermissions(permissions.data(), static_cast<std::int32_t>(permissions.size()));
+    }
+
+    static void ApplyField(const Parameters &params, const char *key, ParamType type, const char *value,
+                           std::size_t size) {
+        switch (type) {
+        case ParamType::Int:
+            params.setInt(key, Load<int>(value));
+            break;
+        case ParamType::Long:
+            params.setLong(key, Load<long>(value));
+            break;
+        case ParamType::Bool:
+            params.setBool(key, Load<bool>(value));
+            break;
+        case ParamType::Char:
+            params.setChar(key, *value);
+            break;
+        case ParamType::Double:
+            params.setDouble(key, Load<double>(value));
+            break;
+        case ParamType::IntArray:
+            params.setIntArray(key, reinterpret_cast<const int *>(value), size / sizeof(int));
+            break;
+        case ParamType::LongArray:
+            params.setLongArray(key, reinterpret_cast<const long *>(value), size / sizeof(long));
+            break;
+        case ParamType::BoolArray:
+            params.setBoolArray(key, reinterpret_cast<const bool *>(value), size / sizeof(bool));
+            break;
+        case ParamType::CharArray:
+            params.setCharArray(key, value, size);
+            break;
+        case ParamType::DoubleArray:
+            params.setDoubleArray(key, reinterpret_cast<const double *>(value), size / sizeof(double));
+            break;
+        }
+    }
+
+    template <typename T> static T Load(const char *bytes) {
+        T value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    // PublishInfo 没有清除 bundleName/permissions 的接口，只能重建后补上其余字段
+    static void RebuildInfo(Entry &entry) {
+        PublishInfo info(entry.ordered);
+        if (entry.bundleTouched) {
+            info.setBunduleName(entry.bundleName.c_str());
+        } else {
+            entry.bundleName.clear();
+        }
+        std::swap(entry.info, info);
+        if (entry.permissionsTouched) {
+            ApplyPermissions(entry);
+        } else {
+            entry.permissions.clear();
+        }
+        if (entry.code != 0) {
+            entry.info.setCode(entry.code);
+        }
+        if (!entry.data.empty()) {
+            entry.info.setData(entry.data.data(), entry.data.size());
+        }
+        entry.attached = false;
+    }
+
+    // Parameters 没有删除键的接口，去掉本批次没设置的键后重建
+    static void RebuildParameters(Entry &entry) {
+        Parameters params;
+        auto &fields = entry.fields;
+        for (auto it = fields.begin(); it != fields.end();) {
+            if (it->touched != entry.generation) {
+                it = fields.erase(it);
+                continue;
+            }
+            ApplyField(params, it->key.c_str(), it->type, it->bytes.data(), it->bytes.size());
+            ++it;
+        }
+        entry.params = std::move(params);
+        entry.cursor = 0;
+        entry.attached = false;
+    }
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Entry>> idle_[2]; // 下标为 ordered
+    std::size_t maxIdle_;
+    std::atomic<std::uint64_t> created_{0};
+    std::atomic<std::uint64_t> reused_{0};
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> skipped_{0};
+};
+
+#endif
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_POOL_H
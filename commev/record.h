@@ -0,0 +1,202 @@
+#ifndef COMMONEV_RECORD_H
+#define COMMONEV_RECORD_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "event.h"
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+/**
+ * @brief RcvData 的自有拷贝，可以带离 CES 的回调线程
+ * @note NDK 没有遍历参数的接口，需要拷贝的参数要按 key 和类型列出；
+ *       同一个对象反复 assign 时复用已分配的内存，参数列表不变时稳定后不再分配
+ */
+class EventRecord {
+public:
+    struct Value {
+        std::string key;
+        ParamType type = ParamType::Int;
+        bool present = false;
+        union {
+            std::int64_t integer;
+            double real;
+        };
+        std::string bytes; // 数组按元素的原始字节保存
+
+        Value() : integer(0) {}
+    };
+
+    void assign(const RcvData &data, const std::vector<ParamKey> &keys) {
+        Assign(event_, data.event());
+        code_ = data.code();
+        Assign(dataStr_, data.dataStr());
+        Assign(bundleName_, data.bundleName());
+        values_.resize(keys.size());
+        const Parameters::param_type *params = OH_CommonEvent_GetParametersFromRcvData(data.data());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            capture(values_[i], params, keys[i]);
+        }
+    }
+
+    // 从事件日志等外部来源还原，参数随后通过 values() 填写
+    void assign(std::string_view event, std::int32_t code, std::string_view dataStr, std::string_view bundleName) {
+        event_.assign(event.data(), event.size());
+        code_ = code;
+        dataStr_.assign(dataStr.data(), dataStr.size());
+        bundleName_.assign(bundleName.data(), bundleName.size());
+    }
+
+    const std::string &event() const { return event_; }
+    std::int32_t code() const { return code_; }
+    const std::string &dataStr() const { return dataStr_; }
+    const std::string &bundleName() const { return bundleName_; }
+
+    // 拷贝到的参数，未列出或收到的事件里没有的 key 视为不存在
+    const std::vector<Value> &values() const { return values_; }
+    std::vector<Value> &values() { return values_; }
+
+    bool hasKey(std::string_view key) const { return find(key) != nullptr; }
+
+    int getInt(std::string_view key, int defaultValue) const { return scalar(key, ParamType::Int, defaultValue); }
+    long getLong(std::string_view key, long defaultValue) const { return scalar(key, ParamType::Long, defaultValue); }
+    bool getBool(std::string_view key, bool defaultValue) const { return scalar(key, ParamType::Bool, defaultValue); }
+    char getChar(std::string_view key, char defaultValue) const { return scalar(key, ParamType::Char, defaultValue); }
+    double getDouble(std::string_view key, double defaultValue) const {
+        const Value *value = find(key, ParamType::Double);
+        return value ? value->real : defaultValue;
+    }
+
+    std::vector<int> getIntArray(std::string_view key) const { return array<int>(key, ParamType::IntArray); }
+    std::vector<long> getLongArray(std::string_view key) const { return array<long>(key, ParamType::LongArray); }
+    std::vector<std::uint8_t> getBoolArray(std::string_view key) const {
+        return array<std::uint8_t>(key, ParamType::BoolArray);
+    }
+    std::string getCharArray(std::string_view key) const {
+        const Value *value = find(key, ParamType::CharArray);
+        return value ? value->bytes : std::string();
+    }
+    std::vector<double> getDoubleArray(std::string_view key) const {
+        return array<double>(key, ParamType::DoubleArray);
+    }
+
+private:
+    static void Assign(std::string &out, const char *text) {
+        if (text) {
+            out.assign(text);
+        } else {
+            out.clear();
+        }
+    }
+
+    template <typename T> static void AssignArray(std::string &out, const T *array, std::int32_t len) {
+        if (array && len > 0) {
+            out.assign(reinterpret_cast<const char *>(array), len * sizeof(T));
+        } else {
+            out.clear();
+        }
+    }
+
+    static void capture(Value &value, const Parameters::param_type *params, const ParamKey &key) {
+        if (value.key != key.key) {
+            value.key = key.key;
+        }
+        value.type = key.type;
+        value.present = params && OH_CommonEvent_HasKeyInParameters(params, key.key.c_str());
+        if (!value.present) {
+            return;
+        }
+        const char *name = key.key.c_str();
+        switch (key.type) {
+        case ParamType::Int:
+            value.integer = OH_CommonEvent_GetIntFromParameters(params, name, 0);
+            break;
+        case ParamType::Long:
+            value.integer = OH_CommonEvent_GetLongFromParameters(params, name, 0);
+            break;
+        case ParamType::Bool:
+            value.integer = OH_CommonEvent_GetBoolFromParameters(params, name, false);
+            break;
+        case ParamType::Char:
+            value.integer = OH_CommonEvent_GetCharFromParameters(params, name, '\0');
+            break;
+        case ParamType::Double:
+            value.real = OH_CommonEvent_GetDoubleFromParameters(params, name, 0.0);
+            break;
+        case ParamType::IntArray: {
+            int *array = nullptr;
+            AssignArray(value.bytes, array, OH_CommonEvent_GetIntArrayFromParameters(params, name, &array));
+            break;
+        }
+        case ParamType::LongArray: {
+            long *array = nullptr;
+            AssignArray(value.bytes, array, OH_CommonEvent_GetLongArrayFromParameters(params, name, &array));
+            break;
+        }
+        case ParamType::BoolArray: {
+            bool *array = nullptr;
+            AssignArray(value.bytes, array, OH_CommonEvent_GetBoolArrayFromParameters(params, name, &array));
+            break;
+        }
+        case ParamType::CharArray: {
+            char *array = nullptr;
+            AssignArray(value.bytes, array, OH_CommonEvent_GetCharArrayFromParameters(params, name, &array));
+            break;
+        }
+        case ParamType::DoubleArray: {
+            double *array = nullptr;
+            AssignArray(value.bytes, array, OH_CommonEvent_GetDoubleArrayFromParameters(params, name, &array));
+            break;
+        }
+        }
+    }
+
+    const Value *find(std::string_view key) const {
+        for (const auto &value : values_) {
+            if (value.present && value.key == key) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+
+    const Value *find(std::string_view key, ParamType type) const {
+        const Value *value = find(key);
+        return value && value->type == type ? value : nullptr;
+    }
+
+    template <typename T> T scalar(std::string_view key, ParamType type, T defaultValue) const {
+        const Value *value = find(key, type);
+        return value ? static_cast<T>(value->integer) : defaultValue;
+    }
+
+    template <typename T> std::vector<T> array(std::string_view key, ParamType type) const {
+        const Value *value = find(key, type);
+        if (!value) {
+            return {};
+        }
+        std::vector<T> result(value->bytes.size() / sizeof(T));
+        if (!result.empty()) {
+            std::memcpy(result.data(), value->bytes.data(), result.size() * sizeof(T));
+        }
+        return result;
+    }
+
+    std::string event_;
+    std::int32_t code_ = 0;
+    std::string dataStr_;
+    std::string bundleName_;
+    std::vector<Value> values_;
+};
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_RECORD_H
@@ -0,0 +1,430 @@
+#ifndef COMMONEV_REPLAY_H
+#define COMMONEV_REPLAY_H
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "event.h"
+#include "record.h"
+#if OHOS_API_VERSION >= 18
+# include "pool.h"
+#endif
+
+/**
+ * 事件日志：把订阅者收到的事件连同接收时刻追加到二进制文件，之后按原来的节奏回放，
+ * 用于在实验室里复现线上的插拔、广播风暴，测量处理函数的吞吐和长尾延迟。
+ *
+ * 文件格式（本机字节序，只在同一种机器上读写）：
+ *   文件头  "CEVLOG01" | u64 开始记录时的系统时间（纳秒）
+ *   每条    u32 之后的字节数 | u64 距开始记录的时间（纳秒） | i32 code | str event | str data | str bundleName
+ *           | u16 参数个数 | 每个参数：u8 ParamType, str key, 标量为 8 字节（整数为 i64，Double 为 double），数组为 str
+ *   str 为 u32 长度加内容，不带结尾的 '\0'
+ *
+ * NDK 不能遍历参数，记录哪些参数要和 EventRecord 一样按 key 和类型列出，例如用 SchemaKeys<T>()
+ */
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+namespace detail {
+
+inline constexpr char kEventLogMagic[8] = {'C', 'E', 'V', 'L', 'O', 'G', '0', '1'};
+
+[[noreturn]] inline void ThrowLogError(int code, const char *message) {
+#if defined(__cpp_exceptions)
+    throw std::system_error(code, std::generic_category(), message);
+#else
+    (void)code;
+    (void)message;
+    std::abort();
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief 追加写事件日志，可以在多个回调线程上同时调用
+ * @note 打开或 append 写入失败时抛出 std::system_error（generic_category）；
+ *       capture 包装的回调运行在 CES 线程上，异常穿过 C 回调会直接终止进程，所以那里只计数不抛出
+ */
+class EventLogWriter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit EventLogWriter(const std::string &path) : file_(std::fopen(path.c_str(), "wb")), start_(Clock::now()) {
+        if (!file_) {
+            detail::ThrowLogError(errno, "open event log failed");
+        }
+        const auto wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+        buffer_.append(detail::kEventLogMagic, sizeof(detail::kEventLogMagic));
+        Put(buffer_, static_cast<std::uint64_t>(wall.count()));
+        if (const int error = write(); error != 0) {
+            std::fclose(file_);
+            detail::ThrowLogError(error, "write event log failed");
+        }
+    }
+
+    EventLogWriter(const EventLogWriter &) = delete;
+    EventLogWriter &operator=(const EventLogWriter &) = delete;
+
+    ~EventLogWriter() { std::fclose(file_); }
+
+    // 以当前时刻追加
+    void append(const EventRecord &record) {
+        append(record, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_));
+    }
+
+    void append(const EventRecord &record, std::chrono::nanoseconds timestamp) {
+        if (auto result = tryAppend(record, timestamp); !result) {
+            detail::ThrowLogError(result.error().value(), "write event log failed");
+        }
+    }
+
+    // 不抛异常的版本，写入失败时返回 errno 并计入 failures()
+    common::Expected<void> tryAppend(const EventRecord &record) {
+        return tryAppend(record, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_));
+    }
+
+    common::Expected<void> tryAppend(const EventRecord &record, std::chrono::nanoseconds timestamp) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer_.clear();
+        Put(buffer_, std::uint32_t{0}); // 长度最后回填
+        Put(buffer_, static_cast<std::uint64_t>(timestamp.count()));
+        Put(buffer_, record.code());
+        PutString(buffer_, record.event());
+        PutString(buffer_, record.dataStr());
+        PutString(buffer_, record.bundleName());
+        const std::size_t countAt = buffer_.size();
+        Put(buffer_, std::uint16_t{0});
+        std::uint16_t count = 0;
+        for (const auto &value : record.values()) {
+            if (!value.present) {
+                continue;
+            }
+            Put(buffer_, static_cast<std::uint8_t>(value.type));
+            PutString(buffer_, value.key);
+            if (value.type == ParamType::Double) {
+                Put(buffer_, value.real);
+            } else if (value.type < ParamType::IntArray) {
+                Put(buffer_, static_cast<std::int64_t>(value.integer));
+            } else {
+                PutString(buffer_, value.bytes);
+            }
+            ++count;
+        }
+        std::memcpy(&buffer_[countAt], &count, sizeof(count));
+        const auto size = static_cast<std::uint32_t>(buffer_.size() - sizeof(std::uint32_t));
+        std::memcpy(&buffer_[0], &size, sizeof(size));
+        if (const int error = write(); error != 0) {
+            ++failures_;
+            return common::Unexpected(std::error_code(error, std::generic_category()));
+        }
+        ++records_;
+        return {};
+    }
+
+    /**
+     * @brief 包装处理函数：收到的事件先按 keys 记入日志再交给 handler
+     * @note 返回值可以直接作为 Subscriber 的回调，例如 Subscriber(&info, writer.capture(keys, handler))；
+     *       handler 的参数为 (const RcvData &) 或 (const RcvData &, CommonEvent_Subscriber *)，writer 要比订阅者晚析构。
+     *       写日志失败不抛出，只计入 failures()，handler 照常调用
+     */
+    template <typename Handler> auto capture(std::vector<ParamKey> keys, Handler handler) {
+        return [this, keys = std::move(keys), handler = std::move(handler)](const RcvData &data,
+                                                                             CommonEvent_Subscriber *subscriber) mutable {
+            thread_local EventRecord record;
+            record.assign(data, keys);
+            (void)tryAppend(record);
+            if constexpr (std::is_invocable_v<Handler &, const RcvData &, CommonEvent_Subscriber *>) {
+                handler(data, subscriber);
+            } else {
+                handler(data);
+            }
+        };
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fflush(file_);
+    }
+
+    std::uint64_t records() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+
+    // 写入失败的记录数
+    std::uint64_t failures() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return failures_;
+    }
+
+private:
+    template <typename T> static void Put(std::string &out, T value) {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    static void PutString(std::string &out, std::string_view text) {
+        Put(out, static_cast<std::uint32_t>(text.size()));
+        out.append(text.data(), text.size());
+    }
+
+    // 返回 0 或 errno
+    int write() {
+        errno = 0;
+        if (std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+            return errno ? errno : EIO;
+        }
+        return 0;
+    }
+
+    std::FILE *file_;
+    Clock::time_point start_;
+    mutable std::mutex mutex_;
+    std::string buffer_; // 复用，稳定后不再分配
+    std::uint64_t records_ = 0;
+    std::uint64_t failures_ = 0;
+};
+
+/**
+ * @brief 顺序读取事件日志
+ * @note 打开失败或文件头不对时抛出 std::system_error；记录不完整（例如写入时进程被杀）时视为读完
+ */
+class EventLogReader {
+public:
+    explicit EventLogReader(const std::string &path) : file_(std::fopen(path.c_str(), "rb")) {
+        if (!file_) {
+            detail::ThrowLogError(errno, "open event log failed");
+        }
+        char magic[sizeof(detail::kEventLogMagic)];
+        std::uint64_t wall = 0;
+        if (std::fread(magic, 1, sizeof(magic), file_) != sizeof(magic) ||
+            std::memcmp(magic, detail::kEventLogMagic, sizeof(magic)) != 0 ||
+            std::fread(&wall, 1, sizeof(wall), file_) != sizeof(wall)) {
+            std::fclose(file_);
+            detail::ThrowLogError(EINVAL, "not an event log");
+        }
+        startTime_ = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(wall)));
+        body_ = std::ftell(file_);
+    }
+
+    EventLogReader(const EventLogReader &) = delete;
+    EventLogReader &operator=(const EventLogReader &) = delete;
+
+    ~EventLogReader() { std::fclose(file_); }
+
+    // 开始记录时的系统时间
+    std::chrono::system_clock::time_point startTime() const { return startTime_; }
+
+    /**
+     * @brief 读出下一条，timestamp 为距开始记录的时间
+     * @return 读完时返回 false；record 复用已分配的内存
+     */
+    bool next(EventRecord &record, std::chrono::nanoseconds &timestamp) {
+        std::uint32_t size = 0;
+        if (std::fread(&size, 1, sizeof(size), file_) != sizeof(size)) {
+            return false;
+        }
+        buffer_.resize(size);
+        if (std::fread(&buffer_[0], 1, size, file_) != size) {
+            return false;
+        }
+        cursor_ = 0;
+        std::uint64_t time = 0;
+        std::int32_t code = 0;
+        std::string_view event, data, bundleName;
+        std::uint16_t count = 0;
+        if (!Get(time) || !Get(code) || !GetString(event) || !GetString(data) || !GetString(bundleName) ||
+            !Get(count)) {
+            detail::ThrowLogError(EBADMSG, "corrupt event log record");
+        }
+        timestamp = std::chrono::nanoseconds(time);
+        record.assign(event, code, data, bundleName);
+        auto &values = record.values();
+        values.resize(count);
+        for (auto &value : values) {
+            std::uint8_t type = 0;
+            std::string_view key;
+            if (!Get(type) || type > static_cast<std::uint8_t>(ParamType::DoubleArray) || !GetString(key)) {
+                detail::ThrowLogError(EBADMSG, "corrupt event log record");
+            }
+            value.key.assign(key.data(), key.size());
+            value.type = static_cast<ParamType>(type);
+            value.present = true;
+            bool ok;
+            if (value.type == ParamType::Double) {
+                ok = Get(value.real);
+            } else if (value.type < ParamType::IntArray) {
+                ok = Get(value.integer);
+            } else {
+                std::string_view bytes;
+                ok = GetString(bytes);
+                value.bytes.assign(bytes.data(), bytes.size());
+            }
+            if (!ok) {
+                detail::ThrowLogError(EBADMSG, "corrupt event log record");
+            }
+        }
+        return true;
+    }
+
+    // 回到第一条，便于反复回放
+    void rewind() { std::fseek(file_, body_, SEEK_SET); }
+
+private:
+    template <typename T> bool Get(T &value) {
+        if (buffer_.size() - cursor_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, buffer_.data() + cursor_, sizeof(T));
+        cursor_ += sizeof(T);
+        return true;
+    }
+
+    bool GetString(std::string_view &text) {
+        std::uint32_t size = 0;
+        if (!Get(size) || buffer_.size() - cursor_ < size) {
+            return false;
+        }
+        text = std::string_view(buffer_.data() + cursor_, size);
+        cursor_ += size;
+        return true;
+    }
+
+    std::FILE *file_;
+    long body_ = 0; // 第一条记录的位置
+    std::chrono::system_clock::time_point startTime_;
+    std::string buffer_;
+    std::size_t cursor_ = 0;
+};
+
+struct ReplayOptions {
+    double speed = 1.0; // 回放速度的倍数，<= 0 表示不等待、尽快回放
+};
+
+struct ReplayStats {
+    std::uint64_t events = 0;
+    std::chrono::nanoseconds elapsed{0};
+    std::chrono::nanoseconds maxLag{0}; // 实际交给处理函数的时刻比按倍速应到的时刻最多晚了多少，处理跟不上时变大
+};
+
+/**
+ * @brief 按日志中的节奏把事件依次交给 handler(const EventRecord &)，在调用线程上执行
+ * @note 不经过 CES，直接测量处理函数；要让订阅者原样收到请用 Republish
+ */
+template <typename Handler> ReplayStats Replay(EventLogReader &reader, Handler &&handler, ReplayOptions options = {}) {
+    using Clock = std::chrono::steady_clock;
+    ReplayStats stats;
+    EventRecord record;
+    std::chrono::nanoseconds timestamp{0};
+    const auto start = Clock::now();
+    bool first = true;
+    std::chrono::nanoseconds origin{0};
+    while (reader.next(record, timestamp)) {
+        if (first) {
+            origin = timestamp;
+            first = false;
+        }
+        if (options.speed > 0) {
+            const auto due =
+                start + std::chrono::duration_cast<Clock::duration>((timestamp - origin) / options.speed);
+            std::this_thread::sleep_until(due);
+            const auto lag = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - due);
+            if (lag > stats.maxLag) {
+                stats.maxLag = lag;
+            }
+        }
+        handler(static_cast<const EventRecord &>(record));
+        ++stats.events;
+    }
+    stats.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    return stats;
+}
+
+#if OHOS_API_VERSION >= 18
+
+/**
+ * @brief 按日志中的节奏重新发布，订阅者的处理函数原样收到 RcvData
+ * @note 事件经过 CES，只能重放本应用有权发布的事件；主机上由 bench/stub 的回环总线投递。
+ *       bundleName 通过 PublishInfo 带上
+ */
+inline ReplayStats Republish(EventLogReader &reader, PublishPool &pool, ReplayOptions options = {}) {
+    auto lease = pool.acquire();
+    std::vector<std::uint64_t> scratch; // 日志中的数组不保证对齐，先拷到这里
+    auto aligned = [&scratch](const std::string &bytes) {
+        scratch.resize((bytes.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+        if (!bytes.empty()) {
+            std::memcpy(scratch.data(), bytes.data(), bytes.size());
+        }
+        return static_cast<const void *>(scratch.data());
+    };
+    return Replay(
+        reader,
+        [&](const EventRecord &record) {
+            lease.setCode(record.code());
+            lease.setData(record.dataStr());
+            lease.setBundleName(record.bundleName());
+            for (const auto &value : record.values()) {
+                const char *key = value.key.c_str();
+                const std::size_t bytes = value.bytes.size();
+                switch (value.type) {
+                case ParamType::Int:
+                    lease.setInt(key, static_cast<int>(value.integer));
+                    break;
+                case ParamType::Long:
+                    lease.setLong(key, static_cast<long>(value.integer));
+                    break;
+                case ParamType::Bool:
+                    lease.setBool(key, value.integer != 0);
+                    break;
+                case ParamType::Char:
+                    lease.setChar(key, static_cast<char>(value.integer));
+                    break;
+                case ParamType::Double:
+                    lease.setDouble(key, value.real);
+                    break;
+                case ParamType::IntArray:
+                    lease.setIntArray(key, static_cast<const int *>(aligned(value.bytes)), bytes / sizeof(int));
+                    break;
+                case ParamType::LongArray:
+                    lease.setLongArray(key, static_cast<const long *>(aligned(value.bytes)), bytes / sizeof(long));
+                    break;
+                case ParamType::BoolArray:
+                    lease.setBoolArray(key, static_cast<const bool *>(aligned(value.bytes)), bytes / sizeof(bool));
+                    break;
+                case ParamType::CharArray:
+                    lease.setCharArray(key, value.bytes);
+                    break;
+                case ParamType::DoubleArray:
+                    lease.setDoubleArray(key, static_cast<const double *>(aligned(value.bytes)),
+                                         bytes / sizeof(double));
+                    break;
+                }
+            }
+            lease.publish(record.event().c_str());
+        },
+        options);
+}
+
+#endif
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_REPLAY_H
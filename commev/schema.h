@@ -0,0 +1,274 @@
+#ifndef COMMONEV_SCHEMA_H
+#define COMMONEV_SCHEMA_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "event.h"
+#include "pool.h"
+
+/**
+ * 用结构体声明事件的参数，编译期生成成员和参数键的对应关系：
+ *
+ *   struct BatteryStatus {
+ *       int level;
+ *       bool charging;
+ *       std::string vendor;
+ *   };
+ *   COMMEV_SCHEMA(BatteryStatus, "usual.event.BATTERY_STATUS",
+ *                 COMMEV_FIELD(level), COMMEV_FIELD(charging), COMMEV_FIELD_AS(vendor, "vendor_name"));
+ *
+ * COMMEV_SCHEMA 要写在结构体所在的命名空间里，通过 ADL 查找。
+ * 支持的成员类型：int、long、bool、char、double、std::string 以及 int/long/double 的 std::vector
+ */
+#define COMMEV_SCHEMA(Type, EventName, ...)                                                                           \
+    [[maybe_unused]] constexpr auto CommevSchemaOf(const Type *) {                                                     \
+        using type = Type;                                                                                             \
+        return ::OHOS::common::event::detail::MakeSchema<Type>(EventName, __VA_ARGS__);                                \
+    }
+
+// 参数键和成员同名
+#define COMMEV_FIELD(member) ::OHOS::common::event::detail::MakeField(#member, &type::member)
+// 参数键另外指定
+#define COMMEV_FIELD_AS(member, key) ::OHOS::common::event::detail::MakeField(key, &type::member)
+
+namespace OHOS {
+namespace common {
+namespace event {
+
+namespace detail {
+
+template <typename Owner, typename Member> struct SchemaField {
+    const char *key;
+    Member Owner::*member;
+};
+
+template <typename Owner, typename... Fields> struct EventSchema {
+    const char *event;
+    std::tuple<Fields...> fields;
+};
+
+template <typename Owner, typename Member>
+constexpr SchemaField<Owner, Member> MakeField(const char *key, Member Owner::*member) {
+    return {key, member};
+}
+
+template <typename Owner, typename... Fields>
+constexpr EventSchema<Owner, Fields...> MakeSchema(const char *event, Fields... fields) {
+    return {event, std::tuple<Fields...>(fields...)};
+}
+
+constexpr bool KeyEqual(const char *a, const char *b) {
+    while (*a && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+template <typename T> struct AlwaysFalse : std::false_type {};
+
+// 成员类型到参数读写的映射
+template <typename T> struct FieldCodec {
+    static_assert(AlwaysFalse<T>::value, "unsupported member type in event schema");
+};
+
+#define COMMEV_SCALAR_CODEC(T, Name, Type)                                                                             \
+    template <> struct FieldCodec<T> {                                                                                 \
+        static constexpr ParamType type = ParamType::Type;                                                             \
+        template <typename Sink> static void Write(Sink &sink, const char *key, T value) { sink.set##Name(key, value); } \
+        static void Read(const Parameters &params, const char *key, T &value) { value = params.get##Name(key, value); } \
+    }
+
+COMMEV_SCALAR_CODEC(int, Int, Int);
+COMMEV_SCALAR_CODEC(long, Long, Long);
+COMMEV_SCALAR_CODEC(bool, Bool, Bool);
+COMMEV_SCALAR_CODEC(char, Char, Char);
+COMMEV_SCALAR_CODEC(double, Double, Double);
+
+#undef COMMEV_SCALAR_CODEC
+
+#define COMMEV_ARRAY_CODEC(T, Name, Type)                                                                              \
+    template <> struct FieldCodec<std::vector<T>> {                                                                    \
+        static constexpr ParamType type = ParamType::Type;                                                             \
+        template <typename Sink> static void Write(Sink &sink, const char *key, const std::vector<T> &value) {        \
+            sink.set##Name##Array(key, value.data(), value.size());                                                    \
+        }                                                                                                              \
+        static void Read(const Parameters &params, const char *key, std::vector<T> &value) {                          \
+            const auto view = params.get##Name##ArrayView(key);                                                        \
+            value.assign(view.begin(), view.end());                                                                    \
+        }                                                                                                              \
+    }
+
+COMMEV_ARRAY_CODEC(int, Int, IntArray);
+COMMEV_ARRAY_CODEC(long, Long, LongArray);
+COMMEV_ARRAY_CODEC(double, Double, DoubleArray);
+
+#undef COMMEV_ARRAY_CODEC
+
+template <> struct FieldCodec<std::string> {
+    static constexpr ParamType type = ParamType::CharArray;
+    template <typename Sink> static void Write(Sink &sink, const char *key, const std::string &value) {
+        sink.setCharArray(key, value.data(), value.size());
+    }
+    static void Read(const Parameters &params, const char *key, std::string &value) {
+        const auto view = params.getCharArrayView(key);
+        value.assign(view.data(), view.size());
+    }
+};
+
+template <typename Fields, std::size_t... I>
+constexpr bool UniqueKeys(const Fields &fields, std::index_sequence<I...>) {
+    const char *keys[] = {std::get<I>(fields).key...};
+    for (std::size_t i = 0; i < sizeof...(I); ++i) {
+        for (std::size_t j = i + 1; j < sizeof...(I); ++j) {
+            if (KeyEqual(keys[i], keys[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename Fields, std::size_t... I>
+constexpr bool NonEmptyKeys(const Fields &fields, std::index_sequence<I...>) {
+    return ((std::get<I>(fields).key != nullptr && std::get<I>(fields).key[0] != '\0') && ...);
+}
+
+template <typename T> struct MemberOwner;
+template <typename Owner, typename Member> struct MemberOwner<Member Owner::*> {
+    using type = Owner;
+};
+
+} // namespace detail
+
+/**
+ * @brief 事件结构体 T 的编译期描述，由 COMMEV_SCHEMA 生成
+ * @note 第一次使用时检查参数键不为空、互不重复，成员类型都受支持
+ */
+template <typename T> struct Schema {
+    static constexpr auto value = CommevSchemaOf(static_cast<const T *>(nullptr));
+    static constexpr std::size_t size = std::tuple_size_v<decltype(value.fields)>;
+    using indices = std::make_index_sequence<size>;
+
+    static_assert(size > 0, "event schema has no fields");
+    static_assert(detail::NonEmptyKeys(value.fields, indices{}), "empty parameter key in event schema");
+    static_assert(detail::UniqueKeys(value.fields, indices{}), "duplicate parameter key in event schema");
+
+    static constexpr const char *event() { return value.event; }
+
+    // 依次对每个字段调用 fn(key, member, ParamType)
+    template <typename Fn> static void forEach(Fn &&fn) {
+        std::apply(
+            [&fn](const auto &...field) {
+                (fn(field.key, field.member,
+                    detail::FieldCodec<std::remove_cv_t<
+                        std::remove_reference_t<decltype(std::declval<T &>().*(field.member))>>>::type),
+                 ...);
+            },
+            value.fields);
+    }
+};
+
+/**
+ * @brief 编译期取得成员对应的参数键，成员不在 schema 中时编译失败
+ * @note 用于仍需按名字读写 Parameters 的代码，例如 params.getInt(KeyOf<&BatteryStatus::level>(), 0)
+ */
+template <auto Member> constexpr const char *KeyOf() {
+    using Owner = typename detail::MemberOwner<decltype(Member)>::type;
+    constexpr const char *key = std::apply(
+        [](const auto &...field) {
+            const char *found = nullptr;
+            (
+                [&] {
+                    if constexpr (std::is_same_v<decltype(field.member), decltype(Member)>) {
+                        if (field.member == Member) {
+                            found = field.key;
+                        }
+                    }
+                }(),
+                ...);
+            return found;
+        },
+        Schema<Owner>::value.fields);
+    static_assert(key != nullptr, "member is not part of the event schema");
+    return key;
+}
+
+// schema 中全部参数键，用于 EventRecord::assign 和 AsyncOptions::parameters
+template <typename T> std::vector<ParamKey> SchemaKeys() {
+    std::vector<ParamKey> keys;
+    keys.reserve(Schema<T>::size);
+    Schema<T>::forEach([&keys](const char *key, auto, ParamType type) { keys.push_back(ParamKey{key, type}); });
+    return keys;
+}
+
+/**
+ * @brief 把结构体的全部字段写入 sink
+ * @note sink 可以是 Parameters、PublishPool::Lease 或 EventUpdate
+ */
+template <typename T, typename Sink> void Encode(const T &value, Sink &sink) {
+    Schema<T>::forEach([&](const char *key, auto member, ParamType) {
+        using Member = std::remove_cv_t<std::remove_reference_t<decltype(value.*member)>>;
+        detail::FieldCodec<Member>::Write(sink, key, value.*member);
+    });
+}
+
+/**
+ * @brief 从参数中读出结构体的字段
+ * @return 全部参数键都存在时返回 true；缺少的字段保持原值
+ */
+template <typename T> bool Decode(const Parameters &params, T &value) {
+    bool complete = true;
+    Schema<T>::forEach([&](const char *key, auto member, ParamType) {
+        using Member = std::remove_cv_t<std::remove_reference_t<decltype(value.*member)>>;
+        if (!params.hasKey(key)) {
+            complete = false;
+            return;
+        }
+        detail::FieldCodec<Member>::Read(params, key, value.*member);
+    });
+    return complete;
+}
+
+// 事件名和 schema 不一致时直接返回 false
+template <typename T> bool Decode(const RcvData &data, T &value) {
+    const char *event = data.event();
+    if (!event || std::strcmp(event, Schema<T>::event()) != 0) {
+        return false;
+    }
+    return Decode(data.parameters(), value);
+}
+
+#if OHOS_API_VERSION >= 18
+
+// 按 schema 中的事件名发布，每次新建 PublishInfo 和 Parameters
+template <typename T> void PublishEvent(const T &value, std::int32_t code = 0) {
+    PublishInfo info(false);
+    Parameters params;
+    Encode(value, params);
+    info.setCode(code);
+    info.setParameters(params);
+    Publish(Schema<T>::event(), info);
+}
+
+// 借用池中的发布对象，值没变的字段不会重复写入
+template <typename T> void PublishEvent(PublishPool::Lease &lease, const T &value, std::int32_t code = 0) {
+    lease.setCode(code);
+    Encode(value, lease);
+    lease.publish(Schema<T>::event());
+}
+
+#endif
+
+} // namespace event
+} // namespace common
+} // namespace OHOS
+
+#endif // COMMONEV_SCHEMA_H
@@ -3,7 +3,9 @@
 
 #include <ddk/ddk_api.h>
 #include <ddk/ddk_types.h>
+#include <cstdlib>
 #include <memory>
+#include <optional>
 #include <string>
 #include <system_error>
 
@@ -18,9 +20,16 @@ namespace DDK {
 
 template <typename T> using sptr = std::shared_ptr<T>;
 
+// 关闭异常时出错直接终止进程
+#if defined(__cpp_exceptions)
+# define DDK_THROW_ERROR(code, message) throw std::system_error((code), DDKErrorCategory::Instance(), (message))
+#else
+# define DDK_THROW_ERROR(code, message) std::abort()
+#endif
+
 #define DDK_CHECK_ERROR(exp, message)                                                                                  \
     if (auto __code = (exp); __code != DDK_SUCCESS)                                                                    \
-    throw std::system_error(__code, DDKErrorCategory::Instance(), (message))
+    DDK_THROW_ERROR(__code, message)
 
 #define DDK_CHECK_ERROR_INLINE_DEFAULT(exp) DDK_CHECK_ERROR(exp, #exp)
 
@@ -73,8 +82,9 @@ public:
         DDK_CHECK_ERROR_INLINE_DEFAULT(OH_DDK_CreateAshmem(name, size, &ashmem_));
     }
     ~Ashmem() {
+        // 析构函数不能抛异常，释放失败时只能忽略
         if (ashmem_) {
-            DDK_CHECK_ERROR_INLINE_DEFAULT(OH_DDK_DestroyAshmem(ashmem_));
+            OH_DDK_DestroyAshmem(ashmem_);
         }
     }
 
@@ -83,6 +93,7 @@ public:
     }
     void unMemMap() override { DDK_CHECK_ERROR_INLINE_DEFAULT(OH_DDK_UnmapAshmem(ashmem_)); }
 
+    struct DDK_Ashmem *ashmem() const { return ashmem_; }
     std::int32_t fd() const override { return ashmem_ ? ashmem_->ashmemFd : -1; }
     const uint8_t *address() const { return ashmem_ ? ashmem_->address : nullptr; }
     std::uint32_t size() const override { return ashmem_ ? ashmem_->size : 0; }
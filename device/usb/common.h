@@ -2,21 +2,30 @@
 #define USBDEVICE_COMMON_H
 
 #include <cstdint>
+#include <cstdlib>
 #include <system_error>
 
 #include <usb/usb_ddk_api.h>
 #include <usb/usb_ddk_types.h>
 
 #include "base.h"
+#include "expected.h"
 #include "nlohmann/json.hpp"
 
 namespace OHOS {
 namespace DDK {
 namespace USB {
 
+// 关闭异常时出错直接终止进程，需要处理错误的路径请改用返回 Expected 的 try* 接口
+#if defined(__cpp_exceptions)
+# define USB_THROW_ERROR(code, message) throw std::system_error((code), USBErrorCategory::Instance(), (message))
+#else
+# define USB_THROW_ERROR(code, message) std::abort()
+#endif
+
 #define USB_CHECK_ERROR(exp, message)                                                                                  \
     if (auto __code = (exp); __code != USB_DDK_SUCCESS)                                                                \
-    throw std::system_error(__code, USBErrorCategory::Instance(), (message))
+    USB_THROW_ERROR(__code, message)
 
 #define USB_CHECK_ERROR_INLINE_DEFAULT(exp) USB_CHECK_ERROR(exp, #exp)
 
@@ -162,7 +171,15 @@ protected:
     USBErrorCategory() = default;
 };
 
-// TODO 改异常为返回错误码，或者只在析构函数中返回错误码
+inline std::error_code MakeErrorCode(std::int32_t code) { return std::error_code(code, USBErrorCategory::Instance()); }
+
+// 把 NDK 的返回值转成不抛异常的接口的结果
+inline common::Expected<void> ToExpected(std::int32_t code) {
+    if (code != USB_DDK_SUCCESS) {
+        return common::Unexpected(MakeErrorCode(code));
+    }
+    return {};
+}
 
 constexpr int MAX_PATH = 260;
 
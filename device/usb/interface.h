@@ -36,6 +36,15 @@ public:
             return std::make_shared<Handle>(deviceId, interfaceIndex);
         }
 
+        // 不抛异常的版本，接口被占用等错误通过返回值带出
+        static common::Expected<Handle::sptr> TryClaim(std::uint64_t deviceId, std::uint8_t interfaceIndex) {
+            handle_type handle = UINT64_MAX;
+            if (auto result = ToExpected(OH_Usb_ClaimInterface(deviceId, interfaceIndex, &handle)); !result) {
+                return common::Unexpected(result.error());
+            }
+            return Handle::sptr(new Handle(deviceId, interfaceIndex, handle));
+        }
+
         Handle(std::uint64_t deviceId, std::uint8_t interfaceIndex)
             : deviceId_(deviceId), interfaceIndex_(interfaceIndex) {
             USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_ClaimInterface(deviceId, interfaceIndex, &handle_));
@@ -45,7 +54,12 @@ public:
         Handle &operator=(const Handle &) = delete;
         Handle(Handle &&) = default;
         Handle &operator=(Handle &&) = default;
-        ~Handle() { USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_ReleaseInterface(handle_)); }
+        // 析构函数不能抛异常，释放失败时只能忽略
+        ~Handle() {
+            if (handle_ != UINT64_MAX) {
+                OH_Usb_ReleaseInterface(handle_);
+            }
+        }
 
         std::uint64_t deviceId() const { return deviceId_; }
         std::uint8_t interfaceIndex() const { return interfaceIndex_; }
@@ -62,28 +76,67 @@ public:
         }
 
         void read(std::uint8_t *dataRead, std::uint32_t *dataReadLen, std::uint32_t timeout_ms) const {
+            const UsbControlRequestSetup setupRead = ReadSetup();
+            USB_CHECK_ERROR_INLINE_DEFAULT(
+                OH_Usb_SendControlReadRequest(handle_, &setupRead, timeout_ms, dataRead, dataReadLen));
+        }
+
+        void write(std::uint8_t *dataWrite, std::uint32_t dataWriteLen, std::uint32_t timeout_ms) const {
+            const UsbControlRequestSetup setupWrite = WriteSetup();
+            USB_CHECK_ERROR_INLINE_DEFAULT(
+                OH_Usb_SendControlWriteRequest(handle_, &setupWrite, timeout_ms, dataWrite, dataWriteLen));
+        }
+
+        // 以下为不抛异常的版本，超时、设备忙等错误通过返回值带出
+        common::Expected<std::uint8_t> tryCurrentInterfacesetting() const {
+            std::uint8_t settingIndex = 0;
+            if (auto result = ToExpected(OH_Usb_GetCurrentInterfaceSetting(handle_, &settingIndex)); !result) {
+                return common::Unexpected(result.error());
+            }
+            return settingIndex;
+        }
+
+        common::Expected<void> trySelectInterfacesetting(std::uint8_t settingIndex) const {
+            return ToExpected(OH_Usb_SelectInterfaceSetting(handle_, settingIndex));
+        }
+
+        common::Expected<void> tryRead(std::uint8_t *dataRead, std::uint32_t *dataReadLen,
+                                       std::uint32_t timeout_ms) const {
+            const UsbControlRequestSetup setupRead = ReadSetup();
+            return ToExpected(OH_Usb_SendControlReadRequest(handle_, &setupRead, timeout_ms, dataRead, dataReadLen));
+        }
+
+        common::Expected<void> tryWrite(std::uint8_t *dataWrite, std::uint32_t dataWriteLen,
+                                        std::uint32_t timeout_ms) const {
+            const UsbControlRequestSetup setupWrite = WriteSetup();
+            return ToExpected(
+                OH_Usb_SendControlWriteRequest(handle_, &setupWrite, timeout_ms, dataWrite, dataWriteLen));
+        }
+
+    private:
+        Handle(std::uint64_t deviceId, std::uint8_t interfaceIndex, handle_type handle)
+            : deviceId_(deviceId), interfaceIndex_(interfaceIndex), handle_(handle) {}
+
+        static UsbControlRequestSetup ReadSetup() {
             UsbControlRequestSetup setupRead;
             setupRead.bmRequestType = USB_ENDPOINT_DIR_IN;
             setupRead.bRequest = 0x08;
             setupRead.wValue = 0;
             setupRead.wIndex = 0;
             setupRead.wLength = 0x01;
-            USB_CHECK_ERROR_INLINE_DEFAULT(
-                OH_Usb_SendControlReadRequest(handle_, &setupRead, timeout_ms, dataRead, dataReadLen));
+            return setupRead;
         }
 
-        void write(std::uint8_t *dataWrite, std::uint32_t dataWriteLen, std::uint32_t timeout_ms) const {
+        static UsbControlRequestSetup WriteSetup() {
             UsbControlRequestSetup setupWrite;
             setupWrite.bmRequestType = USB_ENDPOINT_DIR_OUT;
             setupWrite.bRequest = 0x09;
             setupWrite.wValue = 1;
             setupWrite.wIndex = 0;
             setupWrite.wLength = 0;
-            USB_CHECK_ERROR_INLINE_DEFAULT(
-                OH_Usb_SendControlWriteRequest(handle_, &setupWrite, timeout_ms, dataWrite, dataWriteLen));
+            return setupWrite;
         }
 
-    private:
         std::uint64_t deviceId_{UINT64_MAX};
         std::uint8_t interfaceIndex_{UINT8_MAX};
         handle_type handle_{UINT64_MAX};
@@ -11,6 +11,8 @@ namespace USB {
 
 class UsbDeviceMemMap : public MemMap {
 public:
+    using memmap_type = ::UsbDeviceMemMap;
+
     UsbDeviceMemMap(std::uint64_t deviceId, std::size_t size)
         : deviceId_(deviceId)
     {
@@ -18,13 +20,20 @@ public:
     }
 
     ~UsbDeviceMemMap() {
-        USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_DestroyDeviceMemMap (devMmap_));
+        if (devMmap_) {
+            OH_Usb_DestroyDeviceMemMap(devMmap_);
+        }
     }
 
+    void memMap(const uint8_t) override {}
+    void unMemMap() override {}
+
     std::uint64_t deviceId() const { return deviceId_; }
+    memmap_type *memmap() const { return devMmap_; }
     uint8_t * const address() const {
         return devMmap_ ? devMmap_->address : nullptr;
     }
+    std::int32_t fd() const override { return -1; }
     std::uint32_t size() const override {
         return devMmap_ ? devMmap_->size : 0;
     }
@@ -35,11 +44,11 @@ public:
         return devMmap_ ? devMmap_->bufferLength : 0;
     }
     std::uint32_t transferredLength() const override {
-        return devMmap_ ? devMmap_->transferredLength : 0;
+        return devMmap_ ? devMmap_->transferedLength : 0;
     }
 
 private:
-    struct UsbDeviceMemMap * const devMmap_;
+    memmap_type *devMmap_ = nullptr;
     std::uint64_t deviceId_;
 };
 
@@ -48,19 +57,35 @@ public:
     UsbRequestPipe(std::uint64_t interfaceHandle, std::uint8_t endpoint, std::uint32_t timeout)
         : interfaceHandle_(interfaceHandle), endpoint_(endpoint), timeout_(timeout)
     {
+        pipe_.interfaceHandle = interfaceHandle;
+        pipe_.timeout = timeout;
+        pipe_.endpoint = endpoint;
     }
     ~UsbRequestPipe() = default;
 
     void sendRequest(UsbDeviceMemMap *memMap) const {
-        USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_SendPipeRequest(&pipe_, memMap));
+        USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_SendPipeRequest(&pipe_, memMap->memmap()));
     }
 
     void sendRequest(Ashmem *memMap) const {
-        USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_SendPipeRequestWithAshmem(&pipe_, memMap));
+        USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_SendPipeRequestWithAshmem(&pipe_, memMap->ashmem()));
+    }
+
+    // 不抛异常的版本，超时、设备忙等错误通过返回值带出
+    common::Expected<void> trySendRequest(UsbDeviceMemMap *memMap) const {
+        return ToExpected(OH_Usb_SendPipeRequest(&pipe_, memMap->memmap()));
     }
 
+    common::Expected<void> trySendRequest(Ashmem *memMap) const {
+        return ToExpected(OH_Usb_SendPipeRequestWithAshmem(&pipe_, memMap->ashmem()));
+    }
+
+    std::uint64_t interfaceHandle() const { return interfaceHandle_; }
+    std::uint8_t endpoint() const { return endpoint_; }
+    std::uint32_t timeout() const { return timeout_; }
+
 private:
-    struct UsbRequestPipe pipe_;
+    ::UsbRequestPipe pipe_{};
     std::uint64_t interfaceHandle_;
     std::uint8_t endpoint_;
     std::uint32_t timeout_{UINT32_MAX};
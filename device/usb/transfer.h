@@ -0,0 +1,278 @@
+#ifndef USBDEVICE_TRANSFER_H
+#define USBDEVICE_TRANSFER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "pipe.h"
+
+namespace OHOS {
+namespace DDK {
+namespace USB {
+
+// 一次管道请求的结果，data 指向该请求的缓冲区，只在完成回调内有效
+struct UsbTransferResult {
+    std::uint64_t sequence = 0; // submit 返回的序号
+    common::Expected<void> status;
+    const std::uint8_t *data = nullptr;
+    std::uint32_t length = 0; // 实际传输的字节数
+    bool reordered = false;   // 本请求的 NDK 调用比上一个请求的先返回，数据可能先于上一个请求到达，只在 Overlapped 时出现
+};
+
+// 请求发出的方式
+enum class UsbTransferOrder {
+    // 上一个请求的 NDK 调用返回后才发出下一个，数据一定按提交顺序到达。
+    // 各请求的往返不重叠，与传输重叠的只有 prepare 和完成回调，吞吐基本不随深度增加
+    Strict,
+    // 各请求的往返互相重叠。按序号轮流进入 NDK，下一个请求要等上一个工作线程走到 NDK 调用处才发出，
+    // 但同步接口看不到请求何时真正排上端点，上一个线程恰在调用前被调度走时仍可能被超过，
+    // 数据的顺序不作保证，发现乱序时置 UsbTransferResult::reordered 并计入 reordered()；
+    // 适合各请求互相独立，或协议自带序号的端点
+    Overlapped,
+};
+
+struct UsbTransferOptions {
+    UsbTransferOrder order = UsbTransferOrder::Strict;
+};
+
+/**
+ * @brief 用多块缓冲区在一个端点上排队管道请求，Buffer 为 UsbDeviceMemMap 或 Ashmem
+ * @note NDK 的管道请求是同步的，一次只能等一个往返；这里每块缓冲区配一个工作线程，
+ *       最多同时有 depth（即缓冲区块数）个请求已提交，按 UsbTransferOptions::order 发出。
+ *       没有一种方式能同时做到往返重叠和数据有序：默认的 Strict 保证顺序，但往返依次进行，
+ *       只省下 prepare 和回调的时间；Overlapped 让往返重叠，顺序不作保证。
+ *       请求按序号发出，prepare 慢的请求也不会被后面的超过。
+ *       完成回调严格按提交顺序调用，在完成队首请求的工作线程上串行执行，回调返回后缓冲区才会被后面的请求复用；
+ *       prepare 和回调都不能抛异常，回调里也不能再调用 submit 或 drain
+ */
+template <typename Buffer> class UsbTransferEngine {
+public:
+    using Prepare = std::function<void(Buffer &)>;
+    using Completion = std::function<void(const UsbTransferResult &)>;
+
+    UsbTransferEngine(const UsbRequestPipe &pipe, std::vector<std::unique_ptr<Buffer>> buffers,
+                      UsbTransferOptions options = UsbTransferOptions())
+        : pipe_(pipe), options_(options) {
+        if (buffers.empty()) {
+            USB_THROW_ERROR(USB_DDK_INVALID_PARAMETER, "UsbTransferEngine needs at least one buffer");
+        }
+        for (auto &buffer : buffers) {
+            slots_.emplace_back(new Slot(std::move(buffer)));
+        }
+        for (auto &slot : slots_) {
+            slot->worker = std::thread(&UsbTransferEngine::run, this, std::ref(*slot));
+        }
+    }
+
+    // 为每个在途请求在设备 deviceId 上创建一块 bufferSize 字节的内存映射，depth 即同时在途的请求数
+    template <typename B = Buffer, typename = std::enable_if_t<std::is_same_v<B, UsbDeviceMemMap>>>
+    UsbTransferEngine(std::uint64_t deviceId, const UsbRequestPipe &pipe, std::size_t depth, std::size_t bufferSize,
+                      UsbTransferOptions options = UsbTransferOptions())
+        : UsbTransferEngine(pipe, MakeBuffers(deviceId, depth, bufferSize), options) {}
+
+    UsbTransferEngine(const UsbTransferEngine &) = delete;
+    UsbTransferEngine &operator=(const UsbTransferEngine &) = delete;
+
+    // 等在途的请求完成、回调返回后再停止工作线程
+    ~UsbTransferEngine() {
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        for (auto &slot : slots_) {
+            slot->wakeup.notify_one();
+            slot->worker.join();
+        }
+    }
+
+    std::size_t depth() const { return slots_.size(); }
+
+    // 已提交还没调用完成回调的请求数
+    std::size_t inFlight() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<std::size_t>(next_ - delivered_);
+    }
+
+    /**
+     * @brief 回调时标记了 reordered 的请求数
+     * @note 同一端点上的请求按排上端点的顺序完成，这里按 NDK 调用返回的先后推断；
+     *       工作线程在调用返回后、记下完成顺序前被调度走时，可能多报或漏报
+     */
+    std::uint64_t reordered() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reordered_;
+    }
+
+    // 提交一个请求，返回序号；在途请求已有 depth 个时阻塞到最早的请求回调返回
+    std::uint64_t submit(Completion done) { return submit(nullptr, std::move(done)); }
+
+    // 同上，发送前先在提交线程上对分到的缓冲区调用 prepare，OUT 端点在这里填写要发送的数据和长度
+    std::uint64_t submit(Prepare prepare, Completion done) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_.wait(lock, [this] { return next_ - delivered_ < slots_.size(); });
+        const std::uint64_t sequence = next_++;
+        Slot &slot = *slots_[sequence % slots_.size()];
+        if (prepare) {
+            // 序号已经占住，这块缓冲区要等本请求回调后才会再分出去，可以放开锁
+            lock.unlock();
+            prepare(*slot.buffer);
+            lock.lock();
+        }
+        slot.sequence = sequence;
+        slot.done = std::move(done);
+        slot.pending = true;
+        slot.wakeup.notify_one();
+        return sequence;
+    }
+
+    // 以 future 取得结果，传输的数据拷贝一份带出
+    std::future<common::Expected<std::vector<std::uint8_t>>> submitFuture(Prepare prepare = nullptr) {
+        auto promise = std::make_shared<std::promise<common::Expected<std::vector<std::uint8_t>>>>();
+        auto future = promise->get_future();
+        submit(std::move(prepare), [promise](const UsbTransferResult &result) {
+            if (result.status) {
+                promise->set_value(std::vector<std::uint8_t>(result.data, result.data + result.length));
+            } else {
+                promise->set_value(common::Unexpected(result.status.error()));
+            }
+        });
+        return future;
+    }
+
+    // 等已提交的请求全部完成并回调
+    void drain() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_.wait(lock, [this] { return delivered_ == next_; });
+    }
+
+private:
+    struct Slot {
+        explicit Slot(std::unique_ptr<Buffer> buffer) : buffer(std::move(buffer)) {}
+
+        std::unique_ptr<Buffer> buffer;
+        std::thread worker;
+        std::condition_variable wakeup;
+        std::uint64_t sequence = 0;
+        std::uint64_t completion = 0; // NDK 调用返回的先后
+        Completion done;
+        common::Expected<void> status;
+        bool pending = false;  // 已提交，等工作线程发送
+        bool finished = false; // 已发送完，等轮到它回调
+    };
+
+    static std::vector<std::unique_ptr<Buffer>> MakeBuffers(std::uint64_t deviceId, std::size_t depth,
+                                                            std::size_t bufferSize) {
+        std::vector<std::unique_ptr<Buffer>> buffers;
+        for (std::size_t i = 0; i < depth; ++i) {
+            buffers.emplace_back(new Buffer(deviceId, bufferSize));
+        }
+        return buffers;
+    }
+
+    void run(Slot &slot) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            slot.wakeup.wait(lock, [this, &slot] { return slot.pending || stopping_; });
+            if (!slot.pending) {
+                return;
+            }
+            slot.pending = false;
+            turn_.wait(lock, [this, &slot] { return issued_ == slot.sequence; });
+            common::Expected<void> status;
+            if (options_.order == UsbTransferOrder::Strict) {
+                lock.unlock();
+                status = pipe_.trySendRequest(slot.buffer.get());
+                lock.lock();
+                ++issued_;
+                turn_.notify_all();
+            } else {
+                // 等上一个工作线程走到 NDK 调用处；它放出轮次到真正调用之间还要解锁和唤醒，可能被调度走
+                lock.unlock();
+                for (unsigned spins = 0; entering_.load(std::memory_order_acquire) != slot.sequence; ++spins) {
+                    if (spins < 64) {
+                        std::this_thread::yield();
+                    } else {
+                        std::this_thread::sleep_for(std::chrono::microseconds(10));
+                    }
+                }
+                lock.lock();
+                ++issued_;
+                turn_.notify_all();
+                lock.unlock();
+                entering_.store(slot.sequence + 1, std::memory_order_release);
+                status = pipe_.trySendRequest(slot.buffer.get());
+                lock.lock();
+            }
+            slot.status = status;
+            slot.completion = completed_++;
+            slot.finished = true;
+            deliver(lock);
+        }
+    }
+
+    // 按序号依次回调已完成的请求；已经有线程在回调时由它接着处理，保证回调串行且有序
+    void deliver(std::unique_lock<std::mutex> &lock) {
+        if (delivering_) {
+            return;
+        }
+        delivering_ = true;
+        while (delivered_ != next_) {
+            Slot &head = *slots_[delivered_ % slots_.size()];
+            if (!head.finished) {
+                break;
+            }
+            head.finished = false;
+            Completion done = std::move(head.done);
+            UsbTransferResult result;
+            result.sequence = head.sequence;
+            result.status = head.status;
+            result.data = head.buffer->address();
+            result.length = head.buffer->transferredLength();
+            // 按序号回调，完成顺序比上一个请求靠前说明它超过了上一个请求
+            result.reordered = delivered_ != 0 && head.completion < lastCompletion_;
+            lastCompletion_ = head.completion;
+            if (result.reordered) {
+                ++reordered_;
+            }
+            lock.unlock();
+            if (done) {
+                done(result);
+            }
+            lock.lock();
+            ++delivered_;
+            space_.notify_all();
+        }
+        delivering_ = false;
+    }
+
+    const UsbRequestPipe pipe_;
+    const UsbTransferOptions options_;
+    std::vector<std::unique_ptr<Slot>> slots_; // 序号为 n 的请求用第 n % depth 块
+    mutable std::mutex mutex_;
+    std::condition_variable space_; // 有请求回调完成
+    std::condition_variable turn_;  // 轮到下一个序号发出
+    std::uint64_t issued_ = 0;      // 已放出轮次的请求数，也是下一个可以发出的序号
+    std::atomic<std::uint64_t> entering_{0}; // Overlapped 时已走到 NDK 调用处的请求数
+    std::uint64_t next_ = 0;        // 下一个提交的序号
+    std::uint64_t delivered_ = 0;   // 已回调的请求数，回调按序号进行，也是下一个要回调的序号
+    std::uint64_t completed_ = 0;   // NDK 调用已返回的请求数
+    std::uint64_t lastCompletion_ = 0; // 上一个回调的请求的完成顺序
+    std::uint64_t reordered_ = 0;
+    bool delivering_ = false;
+    bool stopping_ = false;
+};
+
+} // namespace USB
+} // namespace DDK
+} // namespace OHOS
+
+#endif // USBDEVICE_TRANSFER_H
@@ -49,7 +49,7 @@ namespace USB {
 
 /**
  * @brief 监听USB插拔事件
- * @note singleton
+ * @note 可以用 Instance() 取全局实例，也可以各自创建互不相干的监听者
  */
 class USBEventListener {
     // 禁用拷贝构造后，移动自动也禁用了
@@ -59,6 +59,8 @@ class USBEventListener {
 public:
     using NotifyCallback = std::function<void(const common::event::RcvData &, void *userData)>;
 
+    explicit USBEventListener() = default;
+
     static USBEventListener &Instance() {
         static USBEventListener instance;
         return instance;
@@ -79,15 +81,17 @@ public:
         if (subscriber_) {
             return;
         }
-        std::vector<const char *> events;
+        std::vector<std::pair<const char *, common::event::EventDispatcher::Handler>> handlers;
         if (onAttach_.has_value()) {
-            events.emplace_back(COMMON_EVENT_USB_DEVICE_ATTACHED);
+            handlers.emplace_back(COMMON_EVENT_USB_DEVICE_ATTACHED, *onAttach_);
         }
         if (onDetach_.has_value()) {
-            events.emplace_back(COMMON_EVENT_USB_DEVICE_DETACHED);
+            handlers.emplace_back(COMMON_EVENT_USB_DEVICE_DETACHED, *onDetach_);
         }
-        common::event::SubscribeInfo info(events.data(), events.size());
-        subscriber_.reset(new common::event::Subscriber(&info, OnEvent));
+        dispatcher_.reset(new common::event::EventDispatcher(handlers.begin(), handlers.end()));
+        common::event::SubscribeInfo info = dispatcher_->subscribeInfo();
+        subscriber_.reset(new common::event::Subscriber(
+            &info, [this](const common::event::RcvData &data) { dispatcher_->dispatch(data); }));
         subscriber_->subscribe();
         subscribed_ = true;
     }
@@ -101,18 +105,6 @@ public:
     }
 
 private:
-    explicit USBEventListener() : subscriber_(nullptr) {}
-
-    static void OnEvent(const CommonEvent_RcvData *data) {
-        const common::event::RcvData rcvData(data);
-        const auto &lis = Instance();
-        if (std::strcmp(rcvData.event(), COMMON_EVENT_USB_DEVICE_ATTACHED) == 0) {
-            (*lis.onAttach_)(rcvData);
-        } else if (std::strcmp(rcvData.event(), COMMON_EVENT_USB_DEVICE_DETACHED) == 0) {
-            (*lis.onDetach_)(rcvData);
-        }
-    }
-
     struct Notifyer {
         NotifyCallback notify;
         void *userData{nullptr};
@@ -121,6 +113,7 @@ private:
         }
     };
     std::atomic_bool subscribed_ = false;
+    std::unique_ptr<common::event::EventDispatcher> dispatcher_; // 要比 subscriber_ 晚析构，回调里还会用到
     std::unique_ptr<common::event::Subscriber> subscriber_;
     std::optional<Notifyer> onAttach_;
     std::optional<Notifyer> onDetach_;
@@ -142,26 +135,65 @@ public:
         enumerate();
 #endif
     }
-    ~USBHostManager() { ungrab(); }
+    ~USBHostManager() {
+        if (grabbed_) {
+            ungrab();
+        }
+    }
 
     static USBHostManager &Instance() {
         static USBHostManager instance;
         return instance;
     }
 
-    void grab() const { USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_Init()); }
-    void ungrab() const { OH_Usb_Release(); }
+    // 不抛异常的版本，DDK 初始化失败时通过返回值带出
+    static common::Expected<std::unique_ptr<USBHostManager>> TryCreate() {
+        std::unique_ptr<USBHostManager> manager(new USBHostManager(NoGrab{}));
+        if (auto result = manager->tryGrab(); !result) {
+            return common::Unexpected(result.error());
+        }
+#if OHOS_API_VERSION >= 18
+        if (auto result = manager->tryEnumerate(); !result) {
+            return common::Unexpected(result.error());
+        }
+#endif
+        return manager;
+    }
+
+    void grab() {
+        USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_Init());
+        grabbed_ = true;
+    }
+    void ungrab() {
+        OH_Usb_Release();
+        grabbed_ = false;
+    }
+
+    common::Expected<void> tryGrab() {
+        auto result = ToExpected(OH_Usb_Init());
+        grabbed_ = grabbed_ || result.has_value();
+        return result;
+    }
 
 #if OHOS_API_VERSION >= 18
     void enumerate() {
+        if (auto result = tryEnumerate(); !result) {
+            USB_THROW_ERROR(result.error().value(), "OH_Usb_GetDevices(&deviceArray)");
+        }
+    }
+
+    common::Expected<void> tryEnumerate() {
+        std::vector<std::uint64_t> deviceIds(MAX_USB_DEVICE_NUM);
         Usb_DeviceArray deviceArray{};
-        deviceArray.deviceIds = new uint64_t[MAX_USB_DEVICE_NUM];
-        USB_CHECK_ERROR_INLINE_DEFAULT(OH_Usb_GetDevices(&deviceArray));
+        deviceArray.deviceIds = deviceIds.data();
+        if (auto result = ToExpected(OH_Usb_GetDevices(&deviceArray)); !result) {
+            return result;
+        }
         devices_.reserve(deviceArray.num);
         for (std::size_t i = 0; i < deviceArray.num; i++) {
-            auto device = USBDevice::Get(deviceArray.deviceIds[i]);
-            devices_.emplace(device.identifier(), device);
+            devices_.emplace(deviceIds[i], USBDevice(deviceIds[i]));
         }
+        return {};
     }
 #endif
     const std::unordered_map<std::uint64_t, USBDevice> &devices() const { return devices_; }
@@ -180,7 +212,11 @@ public:
     }
 
 private:
+    struct NoGrab {};
+    explicit USBHostManager(NoGrab) {}
+
     std::unordered_map<std::uint64_t, USBDevice> devices_;
+    bool grabbed_ = false;
 };
 
 } // namespace USB
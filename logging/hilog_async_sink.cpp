@@ -0,0 +1,264 @@
+#include "hilog_async_sink.h"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "hilog_deferred.h"
+
+namespace OHOS {
+
+static std::size_t RoundUpPowerOfTwo(std::size_t n) {
+    std::size_t result = 2;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+AsyncLogSink::AsyncLogSink(LogSink &downstream, const AsyncLogOptions &options)
+    : downstream_(downstream), options_(options) {
+    options_.capacity = RoundUpPowerOfTwo(options_.capacity);
+    if (options_.recordSize < 2) {
+        options_.recordSize = 2;
+    }
+    mask_ = options_.capacity - 1;
+    slots_.reset(new Slot[options_.capacity]);
+    text_.reset(new char[options_.capacity * options_.recordSize]);
+    for (std::size_t i = 0; i < options_.capacity; ++i) {
+        slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    drainer_ = std::thread(&AsyncLogSink::run, this);
+}
+
+AsyncLogSink::~AsyncLogSink() { stop(); }
+
+void AsyncLogSink::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        stopping_.store(true, std::memory_order_seq_cst);
+    }
+    wakeup_.notify_one();
+    drainer_.join();
+    // 后台线程退出后可能还有最后一刻写进来的记录，与 write 末尾的检查配对
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    drain();
+    downstream_.flush();
+}
+
+void AsyncLogSink::write(LogLevel level, unsigned int domain, const char *tag, const char *msg, std::size_t len) {
+    if (stopping_.load(std::memory_order_acquire)) {
+        downstream_.write(level, domain, tag, msg, len);
+        return;
+    }
+    if (len >= options_.recordSize) {
+        len = options_.recordSize - 1;
+    }
+    switch (options_.policy) {
+    case OverflowPolicy::DropNewest:
+        if (!tryPush(level, domain, tag, msg, len)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        break;
+    case OverflowPolicy::DropOldest:
+        // 每次最多挤掉一条；队首恰好正被后台线程取出时腾不出位置，改为丢弃当前记录，不在这里等待
+        if (!tryPush(level, domain, tag, msg, len)) {
+            if (tryPop(nullptr, nullptr)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (!tryPush(level, domain, tag, msg, len)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        break;
+    case OverflowPolicy::Block:
+        for (unsigned spins = 0; !tryPush(level, domain, tag, msg, len); ++spins) {
+            if (stopping_.load(std::memory_order_acquire)) {
+                drain();
+                continue;
+            }
+            wakeDrainer();
+            if (spins < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+        break;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (stopping_.load(std::memory_order_relaxed)) {
+        // stop 已经或正在做最后一次输出，可能看不到刚放进去的记录，自己输出
+        drain();
+        return;
+    }
+    // 与后台线程置 idle_ 后的再检查构成 Dekker 式配对，保证不会漏掉唤醒
+    if (idle_.load(std::memory_order_seq_cst)) {
+        wakeDrainer();
+    }
+}
+
+void AsyncLogSink::flush() {
+    const std::uint64_t target = enqueuePos_.load(std::memory_order_seq_cst);
+    std::unique_lock<std::mutex> lock(mutex_);
+    wakeup_.notify_one();
+    drained_.wait(lock, [this, target] {
+        return consumed_.load(std::memory_order_acquire) >= target || stopping_.load(std::memory_order_acquire);
+    });
+    lock.unlock();
+    downstream_.flush();
+}
+
+bool AsyncLogSink::tryPush(LogLevel level, unsigned int domain, const char *tag, const char *msg, std::size_t len) {
+    std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        std::size_t seq = slot->seq.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->level = level;
+    slot->domain = domain;
+    slot->tag = tag;
+    slot->len = len;
+    char *text = textOf(pos);
+    std::memcpy(text, msg, len);
+    text[len] = '\0';
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+// 把记录拷到 out 和 text 后立即让出槽位，下游输出时不占队列；两者为空时只出队丢弃。
+// 生产者在 DropOldest 策略下也会出队，所以这里按多消费者处理
+bool AsyncLogSink::tryPop(Slot *out, char *text) {
+    std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        std::size_t seq = slot->seq.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = dequeuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    if (out) {
+        out->level = slot->level;
+        out->domain = slot->domain;
+        out->tag = slot->tag;
+        out->len = slot->len;
+        std::memcpy(text, textOf(pos), slot->len);
+        text[slot->len] = '\0';
+    }
+    slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+    consumed_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+std::size_t AsyncLogSink::drain() {
+    std::unique_ptr<char[]> text(new char[options_.recordSize]);
+    return drain(text.get());
+}
+
+std::size_t AsyncLogSink::drain(char *text) {
+    std::size_t count = 0;
+    Slot record;
+    while (tryPop(&record, text)) {
+        downstream_.write(record.level, record.domain, record.tag, text, record.len);
+        ++count;
+    }
+    return count;
+}
+
+void AsyncLogSink::wakeDrainer() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wakeup_.notify_one();
+}
+
+void AsyncLogSink::run() {
+    std::unique_ptr<char[]> text(new char[options_.recordSize]);
+    for (;;) {
+        if (drain(text.get()) > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            drained_.notify_all();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        drained_.notify_all();
+        if (stopping_.load(std::memory_order_acquire)) {
+            return;
+        }
+        idle_.store(true, std::memory_order_seq_cst);
+        // 置 idle_ 之后再看一眼队列，避免和写入线程错过彼此
+        const bool empty = enqueuePos_.load(std::memory_order_seq_cst) == dequeuePos_.load(std::memory_order_seq_cst);
+        if (empty) {
+            wakeup_.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        idle_.store(false, std::memory_order_relaxed);
+    }
+}
+
+static std::mutex asyncMutex;
+static AsyncLogSink *asyncSink = nullptr;
+// 换下来的异步输出端：别的线程（包括延迟日志的后台线程）可能刚取到它还没写完，故意不释放
+static std::vector<std::unique_ptr<AsyncLogSink>> &RetiredSinks() {
+    static auto *sinks = new std::vector<std::unique_ptr<AsyncLogSink>>();
+    return *sinks;
+}
+
+// 调用时持有 asyncMutex
+static void RetireAsyncSink() {
+    AsyncLogSink *sink = asyncSink;
+    asyncSink = nullptr;
+    sink->stop();
+    RetiredSinks().emplace_back(sink);
+}
+
+void EnableAsyncLogging(const AsyncLogOptions &options, LogSink *downstream) {
+    // 进程退出时先切回同步输出端，再把队列中剩余的记录输出完
+    struct ExitFlusher {
+        ~ExitFlusher() { DisableAsyncLogging(); }
+    };
+    static ExitFlusher flusher;
+
+    std::lock_guard<std::mutex> lock(asyncMutex);
+    auto *sink = new AsyncLogSink(downstream ? *downstream : HiLogSink::Instance(), options);
+    SetLogSink(sink);
+    if (asyncSink) {
+        RetireAsyncSink();
+    }
+    asyncSink = sink;
+}
+
+void DisableAsyncLogging() {
+    std::lock_guard<std::mutex> lock(asyncMutex);
+    if (!asyncSink) {
+        return;
+    }
+    // 延迟日志的后台线程也往当前输出端写，先让它把已有的记录经异步输出端按序输出
+    hilogpp::FlushDeferredLogging();
+    SetLogSink(nullptr);
+    RetireAsyncSink();
+}
+
+} // namespace OHOS
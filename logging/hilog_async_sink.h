@@ -0,0 +1,100 @@
+#ifndef LOG_OH_LOG_ASYNC_SINK_H_
+#define LOG_OH_LOG_ASYNC_SINK_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "hilog_sink.h"
+
+namespace OHOS {
+
+// 队列满时的处理策略
+enum class OverflowPolicy {
+    DropNewest, // 丢弃当前写入的记录
+    DropOldest, // 丢弃队列中最老的一条记录为当前记录腾出位置，腾不出时丢弃当前记录
+    Block,      // 阻塞写入线程直到队列有空位
+};
+
+struct AsyncLogOptions {
+    std::size_t capacity = 1024;   // 队列槽位数，向上取整为2的幂
+    std::size_t recordSize = 1024; // 单条记录的最大长度（含终止符），超出部分截断
+    OverflowPolicy policy = OverflowPolicy::DropNewest;
+};
+
+/**
+ * @brief 异步输出端：写入线程把记录放进有界无锁 MPSC 环形队列，由后台线程调用下游输出端
+ * @note 析构时会把队列中剩余的记录全部输出后再退出；析构时不能再有线程在写入，
+ *       无法保证这一点时先 stop 再把对象留到进程结束
+ */
+class AsyncLogSink : public LogSink {
+public:
+    explicit AsyncLogSink(LogSink &downstream, const AsyncLogOptions &options = AsyncLogOptions());
+    ~AsyncLogSink() override;
+
+    AsyncLogSink(const AsyncLogSink &) = delete;
+    AsyncLogSink &operator=(const AsyncLogSink &) = delete;
+
+    void write(LogLevel level, unsigned int domain, const char *tag, const char *msg, std::size_t len) override;
+    void flush() override;
+
+    // 停止后台线程并输出完队列中的记录，之后的 write 直接在调用线程上交给下游；可重复调用
+    void stop();
+
+    // 因队列满而被丢弃的记录数
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    const AsyncLogOptions &options() const { return options_; }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq{0};
+        LogLevel level;
+        unsigned int domain;
+        const char *tag;
+        std::size_t len;
+    };
+
+    bool tryPush(LogLevel level, unsigned int domain, const char *tag, const char *msg, std::size_t len);
+    bool tryPop(Slot *out, char *text);
+    // 在调用线程上输出队列中的记录，text 为 recordSize 字节的暂存区
+    std::size_t drain();
+    std::size_t drain(char *text);
+    void wakeDrainer();
+    void run();
+
+    char *textOf(std::size_t pos) const { return text_.get() + (pos & mask_) * options_.recordSize; }
+
+    LogSink &downstream_;
+    AsyncLogOptions options_;
+    std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<char[]> text_;
+
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::atomic<std::size_t> dequeuePos_{0};
+    alignas(64) std::atomic<std::uint64_t> consumed_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    std::atomic<bool> idle_{false};
+    std::atomic<bool> stopping_{false};
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable drained_;
+    std::thread drainer_;
+};
+
+// 开启异步模式：此后 OHOS::cout/cerr/clog 的记录由后台线程输出，downstream 为空时输出到 hilog
+// 进程正常退出时会先把队列中的记录输出完。再次调用会换上新的异步输出端，旧的按 DisableAsyncLogging 处理
+void EnableAsyncLogging(const AsyncLogOptions &options = AsyncLogOptions(), LogSink *downstream = nullptr);
+
+// 输出完队列中的记录后恢复同步模式。其他线程可能还拿着旧的输出端，所以它只停止不释放，
+// 之后写到它上面的记录直接同步交给下游；反复开关会让每个旧输出端的队列内存保留到进程结束
+void DisableAsyncLogging();
+
+} // namespace OHOS
+
+#endif // LOG_OH_LOG_ASYNC_SINK_H_
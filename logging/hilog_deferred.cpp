@@ -0,0 +1,293 @@
+#include "hilog_deferred.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace hilogpp {
+
+namespace {
+
+struct FormatInfo {
+    LogLevel level;
+    const char *format;
+    const LogTag *tag;
+    std::atomic<bool> announced; // 二进制模式下格式串是否已经输出过
+};
+
+constexpr std::size_t kMaxFormats = 4096;
+
+// 后台线程按 id 直接下标访问，注册只追加不修改，所以读取无需加锁
+std::array<FormatInfo, kMaxFormats> formats;
+std::atomic<FormatId> formatCount{0};
+std::mutex formatMutex;
+
+std::atomic<std::uint64_t> dropped{0};
+
+// 渲染目标，超出 limit 的部分直接截断
+struct RecordText {
+    std::string text;
+    std::size_t limit;
+    void append(const char *data, std::size_t len) {
+        if (text.size() + len > limit) {
+            len = limit - text.size();
+        }
+        text.append(data, len);
+    }
+};
+
+// 记录按8字节对齐，末尾的填充没有初始化，只取参数实际占用的长度
+std::size_t PayloadSize(const char *data, std::size_t size) {
+    const char *p = data;
+    const auto count = static_cast<std::size_t>(static_cast<unsigned char>(*p++));
+    for (std::size_t i = 0; i < count; ++i) {
+        if (detail::IsIndirect(static_cast<ArgType>(*p++))) {
+            std::uint32_t len;
+            std::memcpy(&len, p, sizeof(len));
+            p += sizeof(len) + len;
+        } else {
+            p += sizeof(std::uint64_t);
+        }
+    }
+    return std::min(static_cast<std::size_t>(p - data), size);
+}
+
+class DeferredBackend {
+public:
+    // 线程退出和异步输出端停止时都可能在进程退出阶段访问后台，不析构，退出时由 stop 停掉后台线程
+    static DeferredBackend &Instance() {
+        static DeferredBackend *instance = new DeferredBackend();
+        return *instance;
+    }
+
+    // 停止后台线程并把各线程剩下的记录输出完，之后由 flush 的调用线程负责输出
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!started_ || stopping_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            stopping_.store(true, std::memory_order_release);
+        }
+        worker_.join();
+        std::lock_guard<std::mutex> lock(sweepMutex_);
+        stopped_.store(true, std::memory_order_release);
+        sweep();
+    }
+
+    void configure(const DeferredLogOptions &options) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!started_) {
+            options_ = options;
+        }
+    }
+
+    std::shared_ptr<detail::DeferredBuffer> attach() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto buffer = std::make_shared<detail::DeferredBuffer>(options_.threadBufferSize);
+        buffers_.push_back(buffer);
+        if (!started_) {
+            started_ = true;
+            text_.limit = options_.recordSize;
+            text_.text.reserve(options_.recordSize);
+            worker_ = std::thread(&DeferredBackend::run, this);
+            // 进程退出时先输出完剩下的记录；若已开启异步模式，其退出处理也会先调用 flush，两者先后都不会丢记录
+            static ExitStopper stopper;
+        }
+        return buffer;
+    }
+
+    void flush() {
+        std::vector<std::shared_ptr<detail::DeferredBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!started_) {
+                return;
+            }
+            buffers = buffers_;
+        }
+        for (const auto &buffer : buffers) {
+            while (!buffer->empty() && !stopped_.load(std::memory_order_acquire)) {
+                std::this_thread::sleep_for(options_.pollInterval);
+            }
+        }
+        if (stopped_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(sweepMutex_);
+            sweep();
+        }
+        CurrentLogSink().flush();
+    }
+
+private:
+    struct ExitStopper {
+        ~ExitStopper() { DeferredBackend::Instance().stop(); }
+    };
+
+    DeferredBackend() = default;
+
+    void run() {
+        while (!stopping_.load(std::memory_order_acquire)) {
+            if (sweep() == 0) {
+                std::this_thread::sleep_for(options_.pollInterval);
+            }
+        }
+    }
+
+    std::size_t sweep() {
+        std::vector<std::shared_ptr<detail::DeferredBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // 线程已退出且记录已输出完的缓冲区可以释放了
+            for (auto it = buffers_.begin(); it != buffers_.end();) {
+                if ((*it)->retired() && (*it)->empty()) {
+                    it = buffers_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            buffers = buffers_;
+        }
+        std::size_t count = 0;
+        for (const auto &buffer : buffers) {
+            count += buffer->consume([this](FormatId id, const char *args, std::size_t size) { emit(id, args, size); });
+        }
+        return count;
+    }
+
+    void emit(FormatId id, const char *data, std::size_t size) {
+        if (id >= formatCount.load(std::memory_order_acquire)) {
+            return;
+        }
+        FormatInfo &info = formats[id];
+        text_.text.clear();
+        LogSink &sink = CurrentLogSink();
+        if (!options_.render) {
+            if (!info.announced.exchange(true, std::memory_order_relaxed)) {
+                announce(sink, id, info);
+            }
+            dump(id, data, PayloadSize(data, size));
+        } else {
+            FormatArg args[detail::kMaxDeferredArgs];
+            const auto count = static_cast<std::size_t>(static_cast<unsigned char>(*data++));
+            for (std::size_t i = 0; i < count; ++i) {
+                FormatArg &arg = args[i];
+                arg.type = static_cast<ArgType>(*data++);
+                if (detail::IsIndirect(arg.type)) {
+                    std::uint32_t len;
+                    std::memcpy(&len, data, sizeof(len));
+                    arg.s = std::string_view(data + sizeof(len), len);
+                    data += sizeof(len) + len;
+                } else {
+                    std::memcpy(&arg.u, data, sizeof(std::uint64_t));
+                    data += sizeof(std::uint64_t);
+                }
+            }
+            FormatTo(text_, info.format, args, count);
+        }
+        sink.write(info.level, info.tag->domain(), info.tag->tag(), text_.text.c_str(), text_.text.size());
+    }
+
+    void announce(LogSink &sink, FormatId id, const FormatInfo &info) {
+        std::string line = "[@" + std::to_string(id) + "=" + info.format + "]";
+        sink.write(info.level, info.tag->domain(), info.tag->tag(), line.c_str(), line.size());
+    }
+
+    void dump(FormatId id, const char *data, std::size_t size) {
+        static const char digits[] = "0123456789abcdef";
+        std::string prefix = "[@" + std::to_string(id) + "] ";
+        text_.append(prefix.data(), prefix.size());
+        for (std::size_t i = 0; i < size; ++i) {
+            auto byte = static_cast<unsigned char>(data[i]);
+            const char hex[2] = {digits[byte >> 4], digits[byte & 0x0F]};
+            text_.append(hex, 2);
+        }
+    }
+
+    std::mutex mutex_;
+    DeferredLogOptions options_;
+    bool started_ = false;
+    std::vector<std::shared_ptr<detail::DeferredBuffer>> buffers_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> stopped_{false}; // 后台线程已退出
+    std::thread worker_;
+    std::mutex sweepMutex_;  // 后台线程退出后，stop 和 flush 的调用线程轮流输出
+    RecordText text_{}; // 同一时刻只有一个线程输出，复用内存避免每条记录分配
+};
+
+// 线程退出时通知后台线程，缓冲区等记录输出完后再释放
+struct ThreadBufferHolder {
+    std::shared_ptr<detail::DeferredBuffer> buffer = DeferredBackend::Instance().attach();
+    ~ThreadBufferHolder() { buffer->retire(); }
+};
+
+std::size_t RoundUpPowerOfTwo(std::size_t n) {
+    std::size_t result = 64;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+FormatId RegisterFormat(LogLevel level, const char *format, const LogTag &tag) {
+    std::lock_guard<std::mutex> lock(formatMutex);
+    FormatId id = formatCount.load(std::memory_order_relaxed);
+    if (id >= kMaxFormats) {
+        return kFormatOverflow;
+    }
+    formats[id].level = level;
+    formats[id].format = format;
+    formats[id].tag = &tag;
+    formatCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+void ConfigureDeferredLogging(const DeferredLogOptions &options) { DeferredBackend::Instance().configure(options); }
+
+void FlushDeferredLogging() { DeferredBackend::Instance().flush(); }
+
+std::uint64_t DeferredDropped() { return dropped.load(std::memory_order_relaxed); }
+
+namespace detail {
+
+DeferredBuffer::DeferredBuffer(std::size_t capacity) {
+    capacity = RoundUpPowerOfTwo(capacity);
+    data_.reset(new char[capacity]);
+    mask_ = capacity - 1;
+}
+
+char *DeferredBuffer::reserve(std::size_t size) {
+    const std::size_t capacity = mask_ + 1;
+    std::size_t head = reserved_;
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    const std::size_t toEnd = capacity - (head & mask_);
+    const std::size_t need = toEnd < size ? toEnd + size : size;
+    if (size > capacity || capacity - (head - tail) < need) {
+        return nullptr;
+    }
+    if (toEnd < size) {
+        // 尾部放不下，用填充记录跳回开头，保证每条记录在内存中连续
+        const RecordHeader padding{static_cast<std::uint32_t>(toEnd), kPadding};
+        std::memcpy(data_.get() + (head & mask_), &padding, sizeof(padding));
+        head += toEnd;
+    }
+    reserved_ = head + size;
+    return data_.get() + (head & mask_);
+}
+
+DeferredBuffer &ThreadBuffer() {
+    thread_local ThreadBufferHolder holder;
+    return *holder.buffer;
+}
+
+void CountDropped() { dropped.fetch_add(1, std::memory_order_relaxed); }
+
+} // namespace detail
+
+} // namespace hilogpp
+} // namespace OHOS
@@ -0,0 +1,169 @@
+#ifndef LOG_HILOG_DEFERRED_H_
+#define LOG_HILOG_DEFERRED_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "hilog_format.h"
+#include "hilogpp.h"
+
+namespace OHOS {
+namespace hilogpp {
+
+using FormatId = std::uint32_t;
+
+// 格式串表已满时 RegisterFormat 返回的 id，HILOGPP_DEFER 遇到它改为在调用线程上直接格式化
+constexpr FormatId kFormatOverflow = UINT32_MAX - 1;
+
+// 注册一个调用点的级别、格式串和标签，格式串必须是静态存储的字符串
+FormatId RegisterFormat(LogLevel level, const char *format, const LogTag &tag = LogTag::Default());
+
+struct DeferredLogOptions {
+    std::size_t threadBufferSize = 64 * 1024;            // 每个线程的环形缓冲区字节数，向上取整为2的幂
+    std::size_t recordSize = 1024;                       // 渲染后单条日志的最大长度
+    std::chrono::microseconds pollInterval{1000};        // 后台线程空闲时的轮询间隔
+    bool render = true; // false 时不渲染文本，输出 "[@格式id] 参数十六进制"，格式串在首次出现时以 "[@id=格式串]" 输出一次
+};
+
+// 需要在第一次调用 HILOGPP_DEFER 之前设置，之后再设置不生效
+void ConfigureDeferredLogging(const DeferredLogOptions &options);
+
+// 阻塞到各线程已经写入的二进制记录全部输出为止；进程退出时后台线程停止后，由调用线程直接输出
+void FlushDeferredLogging();
+
+// 因线程缓冲区满而丢弃的记录数
+std::uint64_t DeferredDropped();
+
+namespace detail {
+
+// 单生产者单消费者的字节环形缓冲区，每条记录以 RecordHeader 开头并按8字节对齐
+class DeferredBuffer {
+public:
+    struct RecordHeader {
+        std::uint32_t size; // 含头部的总长度
+        FormatId id;
+    };
+    static constexpr FormatId kPadding = UINT32_MAX;
+
+    explicit DeferredBuffer(std::size_t capacity);
+
+    // 生产者：预留 size 字节的连续空间，空间不足时返回 nullptr
+    char *reserve(std::size_t size);
+    void commit() { head_.store(reserved_, std::memory_order_release); }
+
+    // 消费者：逐条处理已提交的记录，返回处理的条数
+    template <typename Consumer> std::size_t consume(Consumer &&consumer) {
+        std::size_t count = 0;
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        while (tail != head) {
+            const char *record = data_.get() + (tail & mask_);
+            RecordHeader header;
+            std::memcpy(&header, record, sizeof(header));
+            if (header.id != kPadding) {
+                consumer(header.id, record + sizeof(header), header.size - sizeof(header));
+                ++count;
+            }
+            tail += header.size;
+            tail_.store(tail, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool empty() const { return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire); }
+
+    void retire() { retired_.store(true, std::memory_order_release); }
+    bool retired() const { return retired_.load(std::memory_order_acquire); }
+
+private:
+    std::unique_ptr<char[]> data_;
+    std::size_t mask_;
+    std::size_t reserved_ = 0; // 仅生产者访问
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::atomic<bool> retired_{false};
+};
+
+constexpr std::size_t kMaxDeferredArgs = 32;
+
+// 当前线程的缓冲区，首次调用时创建并登记到后台线程
+DeferredBuffer &ThreadBuffer();
+void CountDropped();
+
+// String 和 Bytes 需要把引用的内存拷进记录，其余类型都按8字节保存
+inline bool IsIndirect(ArgType type) { return type == ArgType::String || type == ArgType::Bytes; }
+
+inline std::size_t EncodedSize(const FormatArg &arg) {
+    return 1 + (IsIndirect(arg.type) ? sizeof(std::uint32_t) + arg.s.size() : sizeof(std::uint64_t));
+}
+
+inline char *Encode(char *out, const FormatArg &arg) {
+    *out++ = static_cast<char>(arg.type);
+    if (IsIndirect(arg.type)) {
+        auto len = static_cast<std::uint32_t>(arg.s.size());
+        std::memcpy(out, &len, sizeof(len));
+        std::memcpy(out + sizeof(len), arg.s.data(), len);
+        return out + sizeof(len) + len;
+    }
+    std::memcpy(out, &arg.u, sizeof(std::uint64_t));
+    return out + sizeof(std::uint64_t);
+}
+
+} // namespace detail
+
+/**
+ * @brief 只把格式id和参数的原始字节拷进当前线程的缓冲区，文本由后台线程渲染后再交给输出端
+ * @note 字符串参数会被拷贝，其余参数按值保存；缓冲区满时直接丢弃，不会阻塞调用线程
+ */
+template <typename... Args> void LogDeferred(FormatId id, const Args &...args) {
+    const FormatArg encoded[] = {MakeFormatArg(args)..., FormatArg{}};
+    static_assert(sizeof...(Args) <= detail::kMaxDeferredArgs, "too many arguments for HILOGPP_DEFER");
+    // 头部之后先放一个字节的参数个数，再依次放各参数
+    std::size_t size = sizeof(detail::DeferredBuffer::RecordHeader) + 1;
+    for (std::size_t i = 0; i < sizeof...(Args); ++i) {
+        size += detail::EncodedSize(encoded[i]);
+    }
+    size = (size + 7) & ~std::size_t(7);
+
+    detail::DeferredBuffer &buffer = detail::ThreadBuffer();
+    char *record = buffer.reserve(size);
+    if (!record) {
+        detail::CountDropped();
+        return;
+    }
+    const detail::DeferredBuffer::RecordHeader header{static_cast<std::uint32_t>(size), id};
+    std::memcpy(record, &header, sizeof(header));
+    char *out = record + sizeof(header);
+    *out++ = static_cast<char>(sizeof...(Args));
+    for (std::size_t i = 0; i < sizeof...(Args); ++i) {
+        out = detail::Encode(out, encoded[i]);
+    }
+    buffer.commit();
+}
+
+} // namespace hilogpp
+} // namespace OHOS
+
+/**
+ * @brief 延迟格式化的日志入口，用法：HILOGPP_DEFER(INFO, "ep {} transferred {} bytes", ep, len);
+ * @note 每个调用点只在第一次执行时注册格式串，格式串使用 "{}" 占位符，必须是字符串字面量；
+ *       注册的格式串超过上限后，新的调用点退化为 HILOGPP_FMT
+ */
+#define HILOGPP_DEFER(level, format, ...)                                                                              \
+    do {                                                                                                               \
+        if constexpr (::OHOS::hilogpp::kCompiledIn<LOG_##level>) {                                                     \
+            static const ::OHOS::hilogpp::FormatId hilogppFormatId =                                                   \
+                ::OHOS::hilogpp::RegisterFormat(LOG_##level, format);                                                  \
+            if (!::OHOS::hilogpp::IsLoggable(LOG_##level)) {                                                           \
+            } else if (hilogppFormatId != ::OHOS::hilogpp::kFormatOverflow) {                                          \
+                ::OHOS::hilogpp::LogDeferred(hilogppFormatId, ##__VA_ARGS__);                                          \
+            } else {                                                                                                   \
+                ::OHOS::hilogpp::Print(LOG_##level, format, ##__VA_ARGS__);                                            \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+#endif // LOG_HILOG_DEFERRED_H_
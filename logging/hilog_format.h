@@ -0,0 +1,189 @@
+#ifndef LOG_HILOG_FORMAT_H_
+#define LOG_HILOG_FORMAT_H_
+
+#include <charconv>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace OHOS {
+namespace hilogpp {
+
+// 格式化参数的类型，同时也是二进制记录里参数的类型标记
+enum class ArgType : std::uint8_t {
+    Bool,
+    Char,
+    Int,
+    UInt,
+    Double,
+    Pointer,
+    String,
+    HexInt, // 以十六进制输出的整数
+    Bytes,  // 以十六进制输出的字节串，和 String 一样只引用外部内存
+};
+
+// 以 0x 开头的十六进制输出整数
+struct Hex {
+    unsigned long long value;
+};
+template <typename T> Hex hex(T value) { return Hex{static_cast<unsigned long long>(value)}; }
+
+// 把一段内存按字节输出为连续的十六进制，例如 "0a1bff"
+struct HexBytes {
+    const void *data;
+    std::size_t size;
+};
+
+
+// 类型擦除后的格式化参数，String 只引用外部内存不做拷贝
+struct FormatArg {
+    ArgType type;
+    union {
+        bool b;
+        char c;
+        long long i;
+        unsigned long long u;
+        double d;
+        const void *p;
+    };
+    std::string_view s;
+};
+
+template <typename T> FormatArg MakeFormatArg(const T &value) {
+    FormatArg arg{};
+    if constexpr (std::is_same_v<T, bool>) {
+        arg.type = ArgType::Bool;
+        arg.b = value;
+    } else if constexpr (std::is_same_v<T, char>) {
+        arg.type = ArgType::Char;
+        arg.c = value;
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        arg.type = ArgType::Int;
+        arg.i = value;
+    } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+        arg.type = ArgType::UInt;
+        arg.u = static_cast<unsigned long long>(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        arg.type = ArgType::Double;
+        arg.d = value;
+    } else if constexpr (std::is_same_v<T, Hex>) {
+        arg.type = ArgType::HexInt;
+        arg.u = value.value;
+    } else if constexpr (std::is_same_v<T, HexBytes>) {
+        arg.type = ArgType::Bytes;
+        arg.s = std::string_view(static_cast<const char *>(value.data), value.size);
+    } else if constexpr (std::is_same_v<T, const char *> || std::is_same_v<T, char *>) {
+        arg.type = ArgType::String;
+        arg.s = value ? std::string_view(value) : std::string_view("(null)");
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        arg.type = ArgType::String;
+        arg.s = value;
+    } else if constexpr (std::is_pointer_v<T>) {
+        arg.type = ArgType::Pointer;
+        arg.p = value;
+    } else {
+        static_assert(std::is_pointer_v<T>, "unsupported hilogpp format argument type");
+    }
+    return arg;
+}
+
+// 输出一个参数，Out 需要提供 append(const char *, std::size_t)
+template <typename Out> void FormatValue(Out &out, const FormatArg &arg) {
+    char buf[32];
+    std::to_chars_result result{buf, std::errc()};
+    switch (arg.type) {
+    case ArgType::Bool:
+        arg.b ? out.append("true", 4) : out.append("false", 5);
+        return;
+    case ArgType::Char:
+        out.append(&arg.c, 1);
+        return;
+    case ArgType::Int:
+        result = std::to_chars(buf, buf + sizeof(buf), arg.i);
+        break;
+    case ArgType::UInt:
+        result = std::to_chars(buf, buf + sizeof(buf), arg.u);
+        break;
+    case ArgType::Double:
+        result = std::to_chars(buf, buf + sizeof(buf), arg.d);
+        break;
+    case ArgType::Pointer:
+        buf[0] = '0';
+        buf[1] = 'x';
+        result = std::to_chars(buf + 2, buf + sizeof(buf), reinterpret_cast<std::uintptr_t>(arg.p), 16);
+        break;
+    case ArgType::String:
+        out.append(arg.s.data(), arg.s.size());
+        return;
+    case ArgType::HexInt:
+        buf[0] = '0';
+        buf[1] = 'x';
+        result = std::to_chars(buf + 2, buf + sizeof(buf), arg.u, 16);
+        break;
+    case ArgType::Bytes: {
+        static constexpr char digits[] = "0123456789abcdef";
+        std::size_t used = 0;
+        for (unsigned char byte : arg.s) {
+            buf[used++] = digits[byte >> 4];
+            buf[used++] = digits[byte & 0x0F];
+            if (used == sizeof(buf)) {
+                out.append(buf, used);
+                used = 0;
+            }
+        }
+        out.append(buf, used);
+        return;
+    }
+    }
+    out.append(buf, result.ptr - buf);
+}
+
+/**
+ * @brief 按 "{}" 占位符依次填入参数，"{{" 和 "}}" 分别输出 '{' 和 '}'
+ * @note 参数不足时占位符原样保留，多余的参数被忽略
+ */
+template <typename Out> void FormatTo(Out &out, std::string_view format, const FormatArg *args, std::size_t count) {
+    std::size_t next = 0;
+    std::size_t literal = 0;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const char ch = format[i];
+        if ((ch != '{' && ch != '}') || i + 1 >= format.size()) {
+            continue;
+        }
+        const char follow = format[i + 1];
+        if (follow == ch) {
+            out.append(format.data() + literal, i + 1 - literal);
+            literal = ++i + 1;
+        } else if (ch == '{' && follow == '}' && next < count) {
+            out.append(format.data() + literal, i - literal);
+            FormatValue(out, args[next++]);
+            literal = ++i + 1;
+        }
+    }
+    out.append(format.data() + literal, format.size() - literal);
+}
+
+// 让 Hex/HexBytes 也能直接用于 std::ostream
+struct OStreamOut {
+    std::ostream &os;
+    void append(const char *data, std::size_t len) { os.write(data, static_cast<std::streamsize>(len)); }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Hex &value) {
+    OStreamOut out{os};
+    FormatValue(out, MakeFormatArg(value));
+    return os;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const HexBytes &value) {
+    OStreamOut out{os};
+    FormatValue(out, MakeFormatArg(value));
+    return os;
+}
+
+} // namespace hilogpp
+} // namespace OHOS
+
+#endif // LOG_HILOG_FORMAT_H_
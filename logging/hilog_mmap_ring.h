@@ -0,0 +1,52 @@
+#ifndef LOG_HILOG_MMAP_RING_H_
+#define LOG_HILOG_MMAP_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 崩溃日志环形文件的布局，日志库和离线读取工具共用，不依赖 hilog
+// 文件 = MmapRingHeader + slotCount 个 slotSize 字节的槽位，第 seq 条记录写在 seq % slotCount 号槽位
+
+namespace OHOS {
+namespace hilogpp {
+
+constexpr char kMmapRingMagic[8] = {'H', 'L', 'O', 'G', 'R', 'I', 'N', 'G'};
+constexpr std::uint32_t kMmapRingVersion = 1;
+
+struct MmapRingHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t slotSize;
+    std::uint64_t slotCount;
+    std::atomic<std::uint64_t> next; // 下一个待分配的序号
+    std::uint8_t reserved[32];
+};
+
+enum MmapRingFlags : std::uint8_t {
+    kMmapRingContinued = 1, // 记录在下一个序号的槽位中继续
+    kMmapRingTail = 2,      // 槽位是上一个序号槽位的续接
+    kMmapRingTruncated = 4, // 记录比整个环还长，写入时只保留了开头，这是保留下来的最后一个槽位
+};
+
+struct MmapRingSlot {
+    std::atomic<std::uint64_t> seq; // 写完后置为 序号+1，0 表示空槽或写到一半
+    std::int64_t timeNs;            // CLOCK_REALTIME
+    std::uint32_t domain;
+    std::uint16_t len;
+    std::uint8_t level;
+    std::uint8_t flags;
+    char tag[32];
+    char text[1]; // 实际长度为 slotSize - kMmapRingSlotHeaderSize
+};
+
+constexpr std::size_t kMmapRingSlotHeaderSize = 56;
+
+static_assert(sizeof(MmapRingHeader) == 64, "MmapRingHeader layout changed");
+static_assert(offsetof(MmapRingSlot, text) == kMmapRingSlotHeaderSize, "MmapRingSlot layout changed");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "mmap ring needs lock-free 64-bit atomics");
+
+} // namespace hilogpp
+} // namespace OHOS
+
+#endif // LOG_HILOG_MMAP_RING_H_
@@ -0,0 +1,124 @@
+#include "hilog_mmap_sink.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace OHOS {
+
+using hilogpp::MmapRingHeader;
+using hilogpp::MmapRingSlot;
+
+static void ThrowErrno(const char *what) { throw std::system_error(errno, std::generic_category(), what); }
+
+MmapRingSink::MmapRingSink(const std::string &path, std::size_t bytes, LogSink &downstream, std::uint32_t slotSize)
+    : MmapRingSink(path, bytes, slotSize) {
+    downstream_ = &downstream;
+}
+
+MmapRingSink::MmapRingSink(const std::string &path, std::size_t bytes, std::uint32_t slotSize) : downstream_(nullptr) {
+    if (slotSize <= hilogpp::kMmapRingSlotHeaderSize || slotSize % 8 != 0) {
+        throw std::invalid_argument("MmapRingSink: slotSize must be a multiple of 8 larger than the slot header");
+    }
+    // 槽位里的正文长度是 uint16_t
+    if (slotSize - hilogpp::kMmapRingSlotHeaderSize > UINT16_MAX) {
+        throw std::invalid_argument("MmapRingSink: slotSize is too large, slot text must fit in 65535 bytes");
+    }
+    const std::uint64_t slotCount = bytes > sizeof(MmapRingHeader) ? (bytes - sizeof(MmapRingHeader)) / slotSize : 0;
+    if (slotCount == 0) {
+        throw std::invalid_argument("MmapRingSink: file is too small");
+    }
+    mapSize_ = sizeof(MmapRingHeader) + slotCount * slotSize;
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0640);
+    if (fd < 0) {
+        ThrowErrno("open");
+    }
+    if (::ftruncate(fd, static_cast<off_t>(mapSize_)) != 0) {
+        ::close(fd);
+        ThrowErrno("ftruncate");
+    }
+    map_ = ::mmap(nullptr, mapSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map_ == MAP_FAILED) {
+        map_ = nullptr;
+        ThrowErrno("mmap");
+    }
+
+    header_ = static_cast<MmapRingHeader *>(map_);
+    slots_ = static_cast<char *>(map_) + sizeof(MmapRingHeader);
+    textSize_ = slotSize - hilogpp::kMmapRingSlotHeaderSize;
+    const bool reusable = std::memcmp(header_->magic, hilogpp::kMmapRingMagic, sizeof(header_->magic)) == 0 &&
+                          header_->version == hilogpp::kMmapRingVersion && header_->slotSize == slotSize &&
+                          header_->slotCount == slotCount;
+    if (!reusable) {
+        // 布局不同或者是新文件，整个清空，避免把旧数据当作有效记录
+        std::memset(map_, 0, mapSize_);
+        header_->version = hilogpp::kMmapRingVersion;
+        header_->slotSize = slotSize;
+        header_->slotCount = slotCount;
+        header_->next.store(0, std::memory_order_relaxed);
+        std::memcpy(header_->magic, hilogpp::kMmapRingMagic, sizeof(header_->magic));
+    }
+}
+
+MmapRingSink::~MmapRingSink() {
+    if (map_) {
+        ::munmap(map_, mapSize_);
+    }
+}
+
+MmapRingSlot *MmapRingSink::slotOf(std::uint64_t seq) const {
+    return reinterpret_cast<MmapRingSlot *>(slots_ + (seq % header_->slotCount) * header_->slotSize);
+}
+
+void MmapRingSink::write(LogLevel level, unsigned int domain, const char *tag, const char *msg, std::size_t len) {
+    const std::int64_t now =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    // 一条记录放不下一个槽位时一次性预留连续的多个序号；比整个环还长时只保留开头，否则会覆盖自己的前半部分
+    std::uint64_t parts = len == 0 ? 1 : (len + textSize_ - 1) / textSize_;
+    const bool truncated = parts > header_->slotCount;
+    if (truncated) {
+        parts = header_->slotCount;
+    }
+    const std::uint64_t first = header_->next.fetch_add(parts, std::memory_order_relaxed);
+    for (std::uint64_t i = 0; i < parts; ++i) {
+        MmapRingSlot *slot = slotOf(first + i);
+        // 先作废旧内容，写到一半崩溃时读取工具会跳过这个槽位
+        slot->seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        const std::size_t offset = i * textSize_;
+        const std::size_t n = len - offset < textSize_ ? len - offset : textSize_;
+        slot->timeNs = now;
+        slot->domain = domain;
+        slot->len = static_cast<std::uint16_t>(n);
+        slot->level = static_cast<std::uint8_t>(level);
+        slot->flags = (i + 1 < parts ? hilogpp::kMmapRingContinued : 0) | (i > 0 ? hilogpp::kMmapRingTail : 0) |
+                      (truncated && i + 1 == parts ? hilogpp::kMmapRingTruncated : 0);
+        std::strncpy(slot->tag, tag, sizeof(slot->tag) - 1);
+        slot->tag[sizeof(slot->tag) - 1] = '\0';
+        std::memcpy(slot->text, msg + offset, n);
+        slot->seq.store(first + i + 1, std::memory_order_release);
+    }
+    downstream().write(level, domain, tag, msg, len);
+}
+
+void MmapRingSink::sync() const {
+    if (map_) {
+        ::msync(map_, mapSize_, MS_ASYNC);
+    }
+}
+
+void EnableCrashLogRing(const std::string &path, std::size_t bytes, std::uint32_t slotSize) {
+    // 故意不释放：崩溃日志环要一直用到进程最后一刻，析构反而会让退出阶段的日志写到已解除映射的内存。
+    // 下游不固定，异步模式开关后记录自动转交给新的 BackLogSink()，不会留下指向已停止输出端的引用
+    auto *sink = new MmapRingSink(path, bytes, slotSize);
+    SetFrontLogSink(sink);
+}
+
+} // namespace OHOS
@@ -0,0 +1,51 @@
+#ifndef LOG_HILOG_MMAP_SINK_H_
+#define LOG_HILOG_MMAP_SINK_H_
+
+#include <string>
+
+#include "hilog_mmap_ring.h"
+#include "hilog_sink.h"
+
+namespace OHOS {
+
+/**
+ * @brief 把记录镜像到 mmap 的环形文件后再交给下游输出端，进程崩溃后文件里仍保留着最后的日志
+ * @note 写入只有内存拷贝和原子操作，不产生系统调用；文件可用 hilog_ring_dump 按序还原
+ */
+class MmapRingSink : public LogSink {
+public:
+    // 文件已存在且布局相同时接着写，否则重新初始化；打开或映射失败抛出 std::system_error，
+    // slotSize 须为8的倍数、大于槽位头部且正文不超过 65535 字节，否则抛出 std::invalid_argument
+    MmapRingSink(const std::string &path, std::size_t bytes, LogSink &downstream, std::uint32_t slotSize = 256);
+    // 同上，下游为写入时的 BackLogSink()，用作前置输出端
+    MmapRingSink(const std::string &path, std::size_t bytes, std::uint32_t slotSize = 256);
+    ~MmapRingSink() override;
+
+    MmapRingSink(const MmapRingSink &) = delete;
+    MmapRingSink &operator=(const MmapRingSink &) = delete;
+
+    void write(LogLevel level, unsigned int domain, const char *tag, const char *msg, std::size_t len) override;
+    void flush() override { downstream().flush(); }
+
+    // 主动落盘，正常运行时不需要，进程崩溃时内核会保留已写入的页
+    void sync() const;
+
+private:
+    hilogpp::MmapRingSlot *slotOf(std::uint64_t seq) const;
+    LogSink &downstream() const { return downstream_ ? *downstream_ : BackLogSink(); }
+
+    LogSink *downstream_; // 为空时跟随 BackLogSink()
+    void *map_ = nullptr;
+    std::size_t mapSize_ = 0;
+    hilogpp::MmapRingHeader *header_ = nullptr;
+    char *slots_ = nullptr;
+    std::size_t textSize_ = 0;
+};
+
+// 把崩溃日志环设为前置输出端：记录先在写入线程上进环，再交给 BackLogSink()。
+// 与 EnableAsyncLogging 的先后无关，异步模式开关和进程退出时崩溃日志环都保持在最前面
+void EnableCrashLogRing(const std::string &path, std::size_t bytes, std::uint32_t slotSize = 256);
+
+} // namespace OHOS
+
+#endif // LOG_HILOG_MMAP_SINK_H_
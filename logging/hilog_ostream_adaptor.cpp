@@ -1,19 +1,98 @@
 #include "hilog_ostream_adaptor.h"
+#include "hilogpp.h"
+
+#include <memory>
+#include <unordered_map>
+
+#ifndef LOG_DOMAIN
+# warning "LOG_DOMAIN is not defined, no log will be output"
+#endif
+#ifndef LOG_TAG
+# warning "LOG_TAG is not defined, no log will be output"
+#endif
 
 namespace OHOS {
 
+LogTag &LogTag::Default() {
+    static LogTag &instance = Intern(LOG_DOMAIN, LOG_TAG);
+    return instance;
+}
+
 #ifndef HILOGPP_STREAMBUF_SIZE
 # warning "HILOGPP_STREAMBUF_SIZE is not defined, using default value 1024"
 # define HILOGPP_STREAMBUF_SIZE 1024
 #endif
 
-// 如果日志输出不全，可以再把缓冲区大小改大一些（比如跑单测的场景）
-static OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> coutLogBuf(LOG_INFO);
-static OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> cerrLogBuf(LOG_ERROR);
-static OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> clogLogBuf(LOG_WARN);
+// 是否把超长记录拆成带序号的多片输出，关闭后超长记录会在缓冲区满时直接断开
+#ifndef HILOGPP_CHUNKED_RECORDS
+# define HILOGPP_CHUNKED_RECORDS 1
+#endif
+
+// 缓冲区是线程局部的，每个写过日志的线程各占一份，不宜设得过大
+// 开启分片后超长记录不会再被打断，无需为了个别长日志把缓冲区改大
+static thread_local OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> coutLogBuf(LOG_INFO, HILOGPP_CHUNKED_RECORDS);
+static thread_local OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> cerrLogBuf(LOG_ERROR, HILOGPP_CHUNKED_RECORDS);
+static thread_local OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> clogLogBuf(LOG_WARN, HILOGPP_CHUNKED_RECORDS);
+static thread_local OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> debugLogBuf(LOG_DEBUG, HILOGPP_CHUNKED_RECORDS);
+static thread_local OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> fatalLogBuf(LOG_FATAL, HILOGPP_CHUNKED_RECORDS);
+
+thread_local std::ostream cout(&coutLogBuf);
+thread_local std::ostream cerr(&cerrLogBuf);
+thread_local std::ostream clog(&clogLogBuf);
+static thread_local std::ostream debugLog(&debugLogBuf);
+static thread_local std::ostream fatalLog(&fatalLogBuf);
+
+namespace hilogpp {
+
+static OHLogStreamBuf<HILOGPP_STREAMBUF_SIZE> &BufferOf(LogLevel level) {
+    switch (level) {
+    case LOG_DEBUG:
+        return debugLogBuf;
+    case LOG_WARN:
+        return clogLogBuf;
+    case LOG_ERROR:
+        return cerrLogBuf;
+    case LOG_FATAL:
+        return fatalLogBuf;
+    default:
+        return coutLogBuf;
+    }
+}
+
+void PrintRecord(LogLevel level, std::string_view format, const FormatArg *args, std::size_t count) {
+    auto &buffer = BufferOf(level);
+    FormatTo(buffer, format, args, count);
+    buffer.pubsync();
+}
+
+std::ostream &StreamOf(LogLevel level) {
+    switch (level) {
+    case LOG_DEBUG:
+        return debugLog;
+    case LOG_WARN:
+        return clog;
+    case LOG_ERROR:
+        return cerr;
+    case LOG_FATAL:
+        return fatalLog;
+    default:
+        return cout;
+    }
+}
+
+bool IsLoggable(LogLevel level) { return IsLoggable(LogTag::Default(), level); }
+
+std::ostream &StreamOf(const LogTag &tag, LogLevel level) {
+    // 以标签地址和级别为键，每个线程按需创建
+    thread_local std::unordered_map<const LogTag *, std::unique_ptr<OHLogStream<HILOGPP_STREAMBUF_SIZE>>>
+        streams[LOG_FATAL + 1];
+    auto &slot = streams[level <= LOG_FATAL ? level : LOG_FATAL][&tag];
+    if (!slot) {
+        slot.reset(new OHLogStream<HILOGPP_STREAMBUF_SIZE>(tag, level, HILOGPP_CHUNKED_RECORDS));
+    }
+    return *slot;
+}
 
-std::ostream cout(&coutLogBuf);
-std::ostream cerr(&cerrLogBuf);
-std::ostream clog(&clogLogBuf);
+} // namespace hilogpp
 
 } // namespace OHOS
@@ -1,29 +1,58 @@
 #ifndef LOG_OH_LOG_STREAM_H_
 #define LOG_OH_LOG_STREAM_H_
 
-#ifndef LOG_DOMAIN
-# warning "LOG_DOMAIN is not defined, no log will be output"
-#endif
-#ifndef LOG_TAG
-# warning "LOG_TAG is not defined, no log will be output"
-#endif
-
 #include <ostream>
 #include <streambuf>
 #include <array>
+#include <cstdio>
+#include <cstring>
 #include <hilog/log.h>
 
+#include "hilog_sink.h"
+#include "hilog_tag.h"
+
 namespace OHOS {
 
+// hilog 单条日志的长度上限，超出部分会被 hilog 截断
+#ifndef HILOGPP_MAX_ENTRY_SIZE
+# define HILOGPP_MAX_ENTRY_SIZE 4096
+#endif
+
 // 自定义流缓冲区，将数据通过OH_Log_Print输出
+// 分片模式下，超过缓冲区的记录会在 UTF-8 字符边界处拆成多条，每片带上 "[#序号.片号+]" 头，最后一片不带 '+'
 template<size_t N>
 class OHLogStreamBuf : public std::streambuf {
+    // 分片头 "[#4294967295.4294967295+] " 最长26字节
+    static constexpr std::size_t kHeaderReserve = 32;
+    static constexpr std::size_t kChunkSize =
+        N < HILOGPP_MAX_ENTRY_SIZE - kHeaderReserve ? N : HILOGPP_MAX_ENTRY_SIZE - kHeaderReserve;
+    static_assert(N > 8, "OHLogStreamBuf buffer is too small");
+
 public:
-    // 构造函数，可指定日志标签和级别
-    explicit OHLogStreamBuf(LogLevel level)
-        : level_(level) {
+    // 构造函数，可指定日志级别、是否开启分片以及输出到哪个 domain/tag
+    explicit OHLogStreamBuf(LogLevel level, bool chunked = true, const LogTag &tag = LogTag::Default())
+        : tag_(&tag), level_(level), chunked_(chunked) {
         // 设置输出缓冲区
-        setp(buffer_.begin(), buffer_.end() - 1);  // 预留一个位置给终止符
+        reset();
+    }
+
+    // 线程退出时把还没攒完的记录也输出掉
+    ~OHLogStreamBuf() override { sync(); }
+
+    // 供格式化前端直接写入缓冲区，绕过 std::ostream 的 sentry 和 locale；写满时按 overflow 的规则输出
+    void append(const char *data, std::size_t len) {
+        while (len > 0) {
+            std::size_t room = epptr() - pptr();
+            if (room == 0) {
+                overflow(traits_type::eof());
+                continue;
+            }
+            std::size_t n = len < room ? len : room;
+            std::memcpy(pptr(), data, n);
+            pbump(static_cast<int>(n));
+            data += n;
+            len -= n;
+        }
     }
 
 protected:
@@ -33,6 +62,10 @@ protected:
             *pptr() = static_cast<char>(c);
             pbump(1);
         }
+        if (chunked_) {
+            emitChunk(false);
+            return c;
+        }
         // 刷新缓冲区
         if (sync() == -1) {
             return EOF;
@@ -42,29 +75,113 @@ protected:
 
     // 同步缓冲区，将数据输出
     int sync() override {
-        std::streamsize len = pptr() - pbase();
-        if (len > 0) {
+        std::size_t len = pptr() - pbase();
+        if (chunked_) {
+            // 上一片标了续接，即使这里没有剩余内容也要补一个结束片
+            if (len > 0 || part_ > 0) {
+                emitChunk(true);
+            }
+        } else if (len > 0) {
             // 终止字符串
-            buffer_[len] = '\0';
+            pbase()[len] = '\0';
 
-            (void)OH_LOG_Print(LOG_APP, level_, LOG_DOMAIN, LOG_TAG, "%{public}s", pbase());
+            if (tag_->enabled(level_)) {
+                CurrentLogSink().write(level_, tag_->domain(), tag_->tag(), pbase(), len);
+            }
 
             // 重置缓冲区指针
-            setp(buffer_.begin(), buffer_.end() - 1);
-        } else {
-            return -1;
+            reset();
         }
+        // 空缓冲区也算同步成功，否则 flush() 会给流置上 badbit，之后该线程的日志全部丢失
         return 0;
     }
 
 private:
-    std::array<char, N> buffer_;  // 缓冲区，可根据需要调整大小
+    void reset() {
+        char *payload = buffer_.data() + kHeaderReserve;
+        setp(payload, payload + kChunkSize - 1);  // 预留一个位置给 overflow 的字符
+    }
+
+    // 返回不截断 UTF-8 多字节字符的最长前缀长度
+    static std::size_t Utf8SafeLength(const char *data, std::size_t len) {
+        std::size_t back = 0;
+        while (back < 4 && back < len) {
+            auto byte = static_cast<unsigned char>(data[len - 1 - back]);
+            if ((byte & 0xC0) != 0x80) {
+                // 找到首字节，判断它后面的续字节是否齐全
+                std::size_t need = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+                return need > back + 1 ? len - 1 - back : len;
+            }
+            ++back;
+        }
+        return len;
+    }
+
+    void emitChunk(bool last) {
+        char *payload = pbase();
+        std::size_t len = pptr() - payload;
+        std::size_t cut = last ? len : Utf8SafeLength(payload, len);
+        if (cut == 0) {
+            cut = len;
+        }
+
+        char *begin = payload;
+        if (!last || part_ > 0) {
+            char header[kHeaderReserve];
+            int headerLen = std::snprintf(header, sizeof(header), "[#%u.%u%s] ", seq_, part_ + 1, last ? "" : "+");
+            begin = payload - headerLen;
+            std::memcpy(begin, header, headerLen);
+        }
+        const char saved = payload[cut];
+        payload[cut] = '\0';
+        if (tag_->enabled(level_)) {
+            CurrentLogSink().write(level_, tag_->domain(), tag_->tag(), begin, payload + cut - begin);
+        }
+        payload[cut] = saved;
+
+        if (last) {
+            if (part_ > 0) {
+                ++seq_;
+            }
+            part_ = 0;
+        } else {
+            ++part_;
+        }
+        // 没输出的半个字符挪到下一片开头
+        std::size_t rest = len - cut;
+        std::memmove(payload, payload + cut, rest);
+        reset();
+        pbump(static_cast<int>(rest));
+    }
+
+    std::array<char, kHeaderReserve + kChunkSize + 1> buffer_;  // 缓冲区，前面预留分片头的位置，末尾留给终止符
+    const LogTag *tag_;
     LogLevel level_;
+    bool chunked_;
+    unsigned int seq_ = 0;  // 被拆分过的记录的序号
+    unsigned int part_ = 0; // 当前记录已输出的分片数
+};
+
+/**
+ * @brief 绑定到指定 domain/tag/级别的日志流，自带缓冲区
+ * @note 和 OHLogStreamBuf 一样不是线程安全的，多线程使用时每个线程各建一个，或者用 hilogpp::StreamOf(tag, level)
+ */
+template <size_t N = 1024>
+class OHLogStream : public std::ostream {
+public:
+    OHLogStream(const LogTag &tag, LogLevel level, bool chunked = true)
+        : std::ostream(nullptr), buf_(level, chunked, tag) {
+        rdbuf(&buf_);
+    }
+
+private:
+    OHLogStreamBuf<N> buf_;
 };
 
-extern std::ostream cout;
-extern std::ostream cerr;
-extern std::ostream clog;
+// 每个线程各自持有缓冲区，线程内攒完整条记录后一次性交给输出端，线程之间互不干扰也无需加锁
+extern thread_local std::ostream cout;
+extern thread_local std::ostream cerr;
+extern thread_local std::ostream clog;
 
 } // namespace OHOS
 
@@ -0,0 +1,63 @@
+#include "hilog_ratelimit.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace OHOS {
+namespace hilogpp {
+
+std::int64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void EmitSuppressed(LogLevel level, const char *file, int line, std::uint64_t count) {
+    if (count == 0) {
+        return;
+    }
+    char text[256];
+    int len = std::snprintf(text, sizeof(text), "%s:%d suppressed %llu messages", file, line,
+                            static_cast<unsigned long long>(count));
+    if (len < 0) {
+        return;
+    }
+    if (static_cast<std::size_t>(len) >= sizeof(text)) {
+        len = sizeof(text) - 1;
+    }
+    const LogTag &tag = LogTag::Default();
+    CurrentLogSink().write(level, tag.domain(), tag.tag(), text, len);
+}
+
+namespace {
+
+// 登记过的调用点，只增不删；调用点是常量初始化的静态对象，进程退出时也不会析构
+std::atomic<RateLimitSite *> sites{nullptr};
+
+} // namespace
+
+void FlushSuppressed() {
+    for (RateLimitSite *site = sites.load(std::memory_order_acquire); site; site = site->next_) {
+        const std::uint64_t count = site->suppressed_.exchange(0, std::memory_order_relaxed);
+        EmitSuppressed(site->level_, site->file_, site->line_, count);
+    }
+}
+
+namespace detail {
+
+void RegisterSite(RateLimitSite *site) {
+    // 进程退出时输出还没汇总的条数，早于或晚于异步模式的退出处理都可以
+    struct ExitFlusher {
+        ~ExitFlusher() { FlushSuppressed(); }
+    };
+    static ExitFlusher flusher;
+
+    RateLimitSite *head = sites.load(std::memory_order_relaxed);
+    do {
+        site->next_ = head;
+    } while (!sites.compare_exchange_weak(head, site, std::memory_order_release, std::memory_order_relaxed));
+}
+
+} // namespace detail
+
+} // namespace hilogpp
+} // namespace OHOS
@@ -0,0 +1,190 @@
+#ifndef LOG_HILOG_RATELIMIT_H_
+#define LOG_HILOG_RATELIMIT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "hilogpp.h"
+
+// 被抑制的日志汇总输出的最小间隔
+#ifndef HILOGPP_SUPPRESS_SUMMARY_INTERVAL_MS
+# define HILOGPP_SUPPRESS_SUMMARY_INTERVAL_MS 10000
+#endif
+
+namespace OHOS {
+namespace hilogpp {
+
+std::int64_t SteadyNowNs();
+
+// 输出一条 "<file>:<line> suppressed <count> messages" 汇总
+void EmitSuppressed(LogLevel level, const char *file, int line, std::uint64_t count);
+
+// 立即输出各调用点还没汇总的被抑制条数，不受汇总间隔限制；进程正常退出时会自动调用一次
+void FlushSuppressed();
+
+class RateLimitSite;
+
+namespace detail {
+// 调用点第一次被抑制时登记，供 FlushSuppressed 遍历
+void RegisterSite(RateLimitSite *site);
+} // namespace detail
+
+/**
+ * @brief 调用点限流状态的公共部分：统计被抑制的条数，并按固定间隔输出汇总
+ * @note 各调用点以函数内静态对象存在，全部成员都是原子量，判断过程不加锁。
+ *       汇总在间隔到了之后的下一次调用时输出，不论这次调用是否被放行；
+ *       一阵突发之后再没有调用时，剩下的条数由 FlushSuppressed 输出
+ */
+class RateLimitSite {
+protected:
+    constexpr RateLimitSite() = default;
+
+    void suppress(LogLevel level, const char *file, int line) {
+        if (suppressed_.fetch_add(1, std::memory_order_relaxed) == 0 && !registered_.load(std::memory_order_acquire)) {
+            enlist(level, file, line);
+        }
+        summarize(level, file, line);
+    }
+
+    // 放行前调用，有攒下的条数时先输出汇总，使汇总排在放行的日志之前
+    void pass(LogLevel level, const char *file, int line) {
+        if (suppressed_.load(std::memory_order_relaxed) != 0) {
+            summarize(level, file, line);
+        }
+    }
+
+private:
+    friend void FlushSuppressed();
+    friend void detail::RegisterSite(RateLimitSite *site);
+
+    void summarize(LogLevel level, const char *file, int line) {
+        const std::int64_t now = SteadyNowNs();
+        std::int64_t next = nextSummary_.load(std::memory_order_relaxed);
+        if (now < next) {
+            return;
+        }
+        // 只有抢到本轮汇总的线程负责输出
+        const std::int64_t interval = std::int64_t(HILOGPP_SUPPRESS_SUMMARY_INTERVAL_MS) * 1000000;
+        if (nextSummary_.compare_exchange_strong(next, now + interval, std::memory_order_relaxed)) {
+            // 第一次被抑制时只开始计时，等一个周期后再汇总
+            if (next != 0) {
+                EmitSuppressed(level, file, line, suppressed_.exchange(0, std::memory_order_relaxed));
+            }
+        }
+    }
+
+    void enlist(LogLevel level, const char *file, int line) {
+        if (registered_.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        level_ = level;
+        file_ = file;
+        line_ = line;
+        detail::RegisterSite(this);
+    }
+
+    std::atomic<std::uint64_t> suppressed_{0};
+    std::atomic<std::int64_t> nextSummary_{0};
+    std::atomic<bool> registered_{false};
+    // 以下在登记前写入，之后只读
+    LogLevel level_ = LOG_INFO;
+    const char *file_ = nullptr;
+    int line_ = 0;
+    RateLimitSite *next_ = nullptr;
+};
+
+// 每 n 次输出一次，n 为 0 时视同 1，全部输出
+class EveryN : public RateLimitSite {
+public:
+    constexpr EveryN() = default;
+
+    bool allow(std::uint64_t n, LogLevel level, const char *file, int line) {
+        if (n <= 1 || count_.fetch_add(1, std::memory_order_relaxed) % n == 0) {
+            pass(level, file, line);
+            return true;
+        }
+        suppress(level, file, line);
+        return false;
+    }
+
+private:
+    std::atomic<std::uint64_t> count_{0};
+};
+
+// 只输出前 n 次，之后只做汇总
+class FirstN : public RateLimitSite {
+public:
+    constexpr FirstN() = default;
+
+    bool allow(std::uint64_t n, LogLevel level, const char *file, int line) {
+        // 超出之后只剩一次 load，不再争用 count_
+        if (count_.load(std::memory_order_relaxed) < n && count_.fetch_add(1, std::memory_order_relaxed) < n) {
+            pass(level, file, line);
+            return true;
+        }
+        suppress(level, file, line);
+        return false;
+    }
+
+private:
+    std::atomic<std::uint64_t> count_{0};
+};
+
+// 令牌桶，按 GCRA 实现：只需维护一个理论到达时间，一次 CAS 完成取令牌；perSecond 不大于 0 时全部抑制
+class TokenBucket : public RateLimitSite {
+public:
+    constexpr TokenBucket() = default;
+
+    bool allow(double perSecond, std::uint32_t burst, LogLevel level, const char *file, int line) {
+        if (!(perSecond > 0)) {
+            suppress(level, file, line);
+            return false;
+        }
+        // 间隔和容差限制在约 30 年以内，避免极小的速率或极大的突发在换算成整数时溢出
+        constexpr double kMaxNs = 1e18;
+        const auto interval = static_cast<std::int64_t>(std::min(1e9 / perSecond, kMaxNs));
+        const auto tolerance =
+            static_cast<std::int64_t>(std::min(static_cast<double>(interval) * (burst > 0 ? burst - 1 : 0), kMaxNs));
+        const std::int64_t now = SteadyNowNs();
+        std::int64_t tat = tat_.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::int64_t start = tat > now ? tat : now;
+            if (start - now > tolerance) {
+                suppress(level, file, line);
+                return false;
+            }
+            if (tat_.compare_exchange_weak(tat, start + interval, std::memory_order_relaxed)) {
+                pass(level, file, line);
+                return true;
+            }
+        }
+    }
+
+private:
+    std::atomic<std::int64_t> tat_{0};
+};
+
+} // namespace hilogpp
+} // namespace OHOS
+
+// 为每个调用点生成一个独立的静态限流状态
+#define HILOGPP_SITE(type)                                                                                             \
+    ([]() -> ::OHOS::hilogpp::type & {                                                                                 \
+        static ::OHOS::hilogpp::type site;                                                                             \
+        return site;                                                                                                   \
+    }())
+
+// 每 n 次输出一次，例如 HILOGPP_EVERY_N(WARN, 100) << "transfer failed: " << ec;
+#define HILOGPP_EVERY_N(level, n)                                                                                      \
+    HILOGPP_IF(level, HILOGPP_SITE(EveryN).allow((n), LOG_##level, __FILE__, __LINE__))
+
+// 只输出前 n 次
+#define HILOGPP_FIRST_N(level, n)                                                                                      \
+    HILOGPP_IF(level, HILOGPP_SITE(FirstN).allow((n), LOG_##level, __FILE__, __LINE__))
+
+// 每秒最多 perSecond 条，允许 burst 条突发
+#define HILOGPP_RATE_LIMIT(level, perSecond, burst)                                                                    \
+    HILOGPP_IF(level, HILOGPP_SITE(TokenBucket).allow((perSecond), (burst), LOG_##level, __FILE__, __LINE__))
+
+#endif // LOG_HILOG_RATELIMIT_H_
@@ -0,0 +1,27 @@
+#include "hilog_sink.h"
+
+#include <atomic>
+
+namespace OHOS {
+
+static std::atomic<LogSink *> currentSink{nullptr};
+static std::atomic<LogSink *> frontSink{nullptr};
+
+LogSink &CurrentLogSink() {
+    LogSink *sink = frontSink.load(std::memory_order_acquire);
+    return sink ? *sink : BackLogSink();
+}
+
+LogSink &BackLogSink() {
+    LogSink *sink = currentSink.load(std::memory_order_acquire);
+    return sink ? *sink : HiLogSink::Instance();
+}
+
+LogSink *SetLogSink(LogSink *sink) {
+    LogSink *previous = currentSink.exchange(sink, std::memory_order_acq_rel);
+    return previous ? previous : &HiLogSink::Instance();
+}
+
+LogSink *SetFrontLogSink(LogSink *sink) { return frontSink.exchange(sink, std::memory_order_acq_rel); }
+
+} // namespace OHOS
@@ -0,0 +1,54 @@
+#ifndef LOG_OH_LOG_SINK_H_
+#define LOG_OH_LOG_SINK_H_
+
+#include <cstddef>
+#include <hilog/log.h>
+
+namespace OHOS {
+
+// 日志输出端，OHLogStreamBuf 每攒完一条记录就调用一次 write
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+
+    // msg 保证以'\0'结尾，len 不含终止符；tag 需要在整个进程生命周期内有效
+    virtual void write(LogLevel level, unsigned int domain, const char *tag, const char *msg, std::size_t len) = 0;
+
+    // 阻塞到此前写入的记录全部输出为止
+    virtual void flush() {}
+};
+
+// 默认输出端，在调用线程上直接调用 OH_LOG_Print
+class HiLogSink : public LogSink {
+public:
+    // 异步输出端和崩溃日志环在进程退出阶段还会往这里写，不析构
+    static HiLogSink &Instance() {
+        static HiLogSink *instance = new HiLogSink();
+        return *instance;
+    }
+
+    void write(LogLevel level, unsigned int domain, const char *tag, const char *msg, std::size_t len) override {
+        (void)len;
+        (void)OH_LOG_Print(LOG_APP, level, domain, tag, "%{public}s", msg);
+    }
+
+private:
+    HiLogSink() = default;
+};
+
+// 当前生效的输出端：设置了前置输出端时为前置输出端，否则为 BackLogSink()
+LogSink &CurrentLogSink();
+
+// SetLogSink 设置的输出端，未设置时为 HiLogSink；前置输出端把记录转交给它
+LogSink &BackLogSink();
+
+// 替换输出端并返回之前的输出端，传 nullptr 恢复为 HiLogSink；设置了前置输出端时替换的是它后面的一级
+LogSink *SetLogSink(LogSink *sink);
+
+// 设置前置输出端并返回之前的前置输出端，传 nullptr 取消。前置输出端始终排在最前面，
+// SetLogSink 和异步模式的开关都不影响它，它在 write 时应把记录转交给 BackLogSink()
+LogSink *SetFrontLogSink(LogSink *sink);
+
+} // namespace OHOS
+
+#endif // LOG_OH_LOG_SINK_H_
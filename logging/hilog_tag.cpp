@@ -0,0 +1,70 @@
+#include "hilog_tag.h"
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OHOS {
+
+namespace {
+
+// 关闭的标签使用的阈值，高于所有日志级别
+constexpr int kDisabledThreshold = LOG_FATAL + 1;
+
+struct TagRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<LogTag>> tags;
+
+    // 标签地址要在进程退出阶段也有效（异步输出端、延迟日志的后台线程还会用到），故意不析构
+    static TagRegistry &Instance() {
+        static TagRegistry *instance = new TagRegistry();
+        return *instance;
+    }
+};
+
+} // namespace
+
+LogTag &LogTag::Intern(unsigned int domain, const char *tag) {
+    auto &registry = TagRegistry::Instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto &item : registry.tags) {
+        if (item->domain_ == domain && std::strcmp(item->tag(), tag) == 0) {
+            return *item;
+        }
+    }
+    registry.tags.emplace_back(new LogTag(domain, tag));
+    return *registry.tags.back();
+}
+
+void LogTag::ForEach(const std::function<void(LogTag &)> &visitor) {
+    std::vector<LogTag *> tags;
+    {
+        auto &registry = TagRegistry::Instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto &item : registry.tags) {
+            tags.push_back(item.get());
+        }
+    }
+    // 不持锁回调，visitor 里可以再修改标签
+    for (LogTag *tag : tags) {
+        visitor(*tag);
+    }
+}
+
+void LogTag::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(TagRegistry::Instance().mutex);
+    enabled_.store(enabled, std::memory_order_relaxed);
+    threshold_.store(enabled ? minLevel_.load(std::memory_order_relaxed) : kDisabledThreshold,
+                     std::memory_order_relaxed);
+}
+
+void LogTag::setMinLevel(LogLevel level) {
+    std::lock_guard<std::mutex> lock(TagRegistry::Instance().mutex);
+    minLevel_.store(level, std::memory_order_relaxed);
+    if (enabled_.load(std::memory_order_relaxed)) {
+        threshold_.store(level, std::memory_order_relaxed);
+    }
+}
+
+} // namespace OHOS
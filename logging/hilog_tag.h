@@ -0,0 +1,53 @@
+#ifndef LOG_HILOG_TAG_H_
+#define LOG_HILOG_TAG_H_
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <hilog/log.h>
+
+namespace OHOS {
+
+/**
+ * @brief 驻留的 domain/tag，同一组 domain/tag 只会创建一次，地址在进程内固定且不会释放
+ * @note 热路径上只传 LogTag 指针，是否输出只需一次原子读
+ */
+class LogTag {
+public:
+    // 查找或创建，tag 会被拷贝
+    static LogTag &Intern(unsigned int domain, const char *tag);
+    // 以编译 hilogpp 时的 LOG_DOMAIN/LOG_TAG 创建的默认标签，OHOS::cout 等使用它
+    static LogTag &Default();
+    // 遍历已创建的全部标签
+    static void ForEach(const std::function<void(LogTag &)> &visitor);
+
+    LogTag(const LogTag &) = delete;
+    LogTag &operator=(const LogTag &) = delete;
+
+    unsigned int domain() const { return domain_; }
+    const char *tag() const { return tag_.c_str(); }
+
+    bool enabled(LogLevel level) const { return level >= threshold_.load(std::memory_order_relaxed); }
+
+    // 关闭后该标签的所有日志在格式化之前就被丢弃
+    void setEnabled(bool enabled);
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // 低于 level 的日志不输出，默认全部输出，交给 hilog 自己过滤
+    void setMinLevel(LogLevel level);
+    LogLevel minLevel() const { return minLevel_.load(std::memory_order_relaxed); }
+
+private:
+    LogTag(unsigned int domain, const char *tag) : domain_(domain), tag_(tag) {}
+
+    const unsigned int domain_;
+    const std::string tag_;
+    std::atomic<int> threshold_{0}; // 实际生效的阈值，关闭时高于所有级别
+    // 在锁内修改，读取不加锁
+    std::atomic<bool> enabled_{true};
+    std::atomic<LogLevel> minLevel_{LOG_DEBUG};
+};
+
+} // namespace OHOS
+
+#endif // LOG_HILOG_TAG_H_
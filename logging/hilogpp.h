@@ -0,0 +1,98 @@
+#ifndef LOG_HILOGPP_H_
+#define LOG_HILOGPP_H_
+
+#include "hilog_format.h"
+#include "hilog_ostream_adaptor.h"
+
+// 编译期最低日志级别，低于该级别的 HILOGPP 语句不会生成任何代码
+// 例如 -DHILOGPP_MIN_LEVEL=LOG_WARN 可去掉所有 DEBUG/INFO 日志
+#ifndef HILOGPP_MIN_LEVEL
+# define HILOGPP_MIN_LEVEL LOG_DEBUG
+#endif
+
+namespace OHOS {
+namespace hilogpp {
+
+template <LogLevel Level> constexpr bool kCompiledIn = Level >= HILOGPP_MIN_LEVEL;
+
+// 当前线程指定级别的日志流，INFO/WARN/ERROR 分别对应 OHOS::cout/clog/cerr
+std::ostream &StreamOf(LogLevel level);
+
+// 当前线程绑定到指定标签和级别的日志流
+std::ostream &StreamOf(const LogTag &tag, LogLevel level);
+
+// 标签已开启且 hilog 会输出该级别时返回 true
+inline bool IsLoggable(const LogTag &tag, LogLevel level) {
+    return tag.enabled(level) && OH_LOG_IsLoggable(tag.domain(), tag.tag(), level);
+}
+
+// 以默认标签（库的 LOG_DOMAIN/LOG_TAG）判断该级别当前是否会输出
+bool IsLoggable(LogLevel level);
+
+// 把格式化结果直接写进当前线程该级别的缓冲区并作为一条记录提交
+void PrintRecord(LogLevel level, std::string_view format, const FormatArg *args, std::size_t count);
+
+/**
+ * @brief 用 to_chars 按 "{}" 占位符格式化，参数只做类型擦除不分配内存，不经过 std::ostream
+ * @note 不做 IsLoggable 判断，一般通过 HILOGPP_FMT 调用
+ */
+template <typename... Args> void Print(LogLevel level, std::string_view format, const Args &...args) {
+    const FormatArg packed[] = {MakeFormatArg(args)..., FormatArg{}};
+    PrintRecord(level, format, packed, sizeof...(Args));
+}
+
+// 一条日志语句对应的临时对象，语句结束析构时提交整条记录
+class LogLine {
+public:
+    explicit LogLine(LogLevel level) : stream_(StreamOf(level)) {}
+    LogLine(const LogTag &tag, LogLevel level) : stream_(StreamOf(tag, level)) {}
+    ~LogLine() { stream_.flush(); }
+
+    LogLine(const LogLine &) = delete;
+    LogLine &operator=(const LogLine &) = delete;
+
+    std::ostream &stream() { return stream_; }
+
+private:
+    std::ostream &stream_;
+};
+
+} // namespace hilogpp
+} // namespace OHOS
+
+/**
+ * @brief 流式日志入口，用法：HILOGPP(DEBUG) << "len=" << len;
+ * @note 级别低于 HILOGPP_MIN_LEVEL 时整条语句在编译期被丢弃，
+ *       否则先用 OH_LOG_IsLoggable 判断，不输出时右侧的 operator<< 一个都不会执行
+ */
+#define HILOGPP(level) HILOGPP_IF(level, true)
+
+// 额外附加一个条件，级别可输出且 condition 为真时才格式化，condition 在级别判断之后求值
+#define HILOGPP_IF(level, condition)                                                                                   \
+    if constexpr (!::OHOS::hilogpp::kCompiledIn<LOG_##level>) {                                                        \
+    } else if (!::OHOS::hilogpp::IsLoggable(LOG_##level) || !(condition)) {                                            \
+    } else                                                                                                             \
+        ::OHOS::hilogpp::LogLine(LOG_##level).stream()
+
+/**
+ * @brief 输出到运行时创建的标签，用法：
+ *        static auto &usbTag = OHOS::LogTag::Intern(0xD002, "usb");
+ *        HILOGPP_TAG(usbTag, INFO) << "attached";
+ */
+#define HILOGPP_TAG(tag, level)                                                                                        \
+    if constexpr (!::OHOS::hilogpp::kCompiledIn<LOG_##level>) {                                                        \
+    } else if (!::OHOS::hilogpp::IsLoggable((tag), LOG_##level)) {                                                     \
+    } else                                                                                                             \
+        ::OHOS::hilogpp::LogLine((tag), LOG_##level).stream()
+
+// 格式化日志入口，用法：HILOGPP_FMT(INFO, "ep {} got {} bytes: {}", hex(ep), len, HexBytes{buf, len});
+#define HILOGPP_FMT(level, format, ...)                                                                                \
+    do {                                                                                                               \
+        if constexpr (::OHOS::hilogpp::kCompiledIn<LOG_##level>) {                                                     \
+            if (::OHOS::hilogpp::IsLoggable(LOG_##level)) {                                                            \
+                ::OHOS::hilogpp::Print(LOG_##level, format, ##__VA_ARGS__);                                            \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+#endif // LOG_HILOGPP_H_
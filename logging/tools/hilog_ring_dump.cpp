@@ -0,0 +1,106 @@
+// 读取 MmapRingSink 写下的环形文件，按序号顺序还原日志，用法：hilog_ring_dump <file>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "hilog_mmap_ring.h"
+
+using namespace OHOS::hilogpp;
+
+static const char *LevelName(std::uint8_t level) {
+    static const char *names[] = {"D", "I", "W", "E", "F"};
+    return level >= 3 && level <= 7 ? names[level - 3] : "?";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <ring file>\n", argv[0]);
+        return 2;
+    }
+    int fd = ::open(argv[1], O_RDONLY);
+    struct stat st {};
+    if (fd < 0 || ::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(MmapRingHeader)) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    void *map = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        std::perror("mmap");
+        return 1;
+    }
+    const auto *header = static_cast<const MmapRingHeader *>(map);
+    if (std::memcmp(header->magic, kMmapRingMagic, sizeof(header->magic)) != 0 ||
+        header->version != kMmapRingVersion || header->slotSize <= kMmapRingSlotHeaderSize ||
+        sizeof(MmapRingHeader) + header->slotCount * header->slotSize > static_cast<std::size_t>(st.st_size)) {
+        std::fprintf(stderr, "%s: not a hilogpp ring file\n", argv[1]);
+        return 1;
+    }
+
+    const char *base = static_cast<const char *>(map) + sizeof(MmapRingHeader);
+    const std::size_t textSize = header->slotSize - kMmapRingSlotHeaderSize;
+    std::vector<const MmapRingSlot *> slots;
+    for (std::uint64_t i = 0; i < header->slotCount; ++i) {
+        const auto *slot = reinterpret_cast<const MmapRingSlot *>(base + i * header->slotSize);
+        if (slot->seq.load(std::memory_order_relaxed) != 0 && slot->len <= textSize) {
+            slots.push_back(slot);
+        }
+    }
+    std::sort(slots.begin(), slots.end(), [](const MmapRingSlot *a, const MmapRingSlot *b) {
+        return a->seq.load(std::memory_order_relaxed) < b->seq.load(std::memory_order_relaxed);
+    });
+
+    std::string text;
+    std::uint64_t expected = 0;
+    for (const MmapRingSlot *slot : slots) {
+        const std::uint64_t seq = slot->seq.load(std::memory_order_relaxed) - 1;
+        // 续接的槽位被覆盖或没写完时，前半条记录照样输出
+        if (!text.empty() && seq != expected) {
+            text += " [truncated]";
+            std::printf("%s\n", text.c_str());
+            text.clear();
+        }
+        if (text.empty()) {
+            char stamp[32];
+            std::time_t seconds = static_cast<std::time_t>(slot->timeNs / 1000000000);
+            std::tm tm {};
+            ::localtime_r(&seconds, &tm);
+            std::strftime(stamp, sizeof(stamp), "%m-%d %H:%M:%S", &tm);
+            char prefix[128];
+            std::snprintf(prefix, sizeof(prefix), "%s.%03lld %s %05X/%.*s: ", stamp,
+                          static_cast<long long>(slot->timeNs / 1000000 % 1000), LevelName(slot->level),
+                          slot->domain, static_cast<int>(sizeof(slot->tag)), slot->tag);
+            text = prefix;
+            // 记录的前半部分已经被覆盖
+            if (slot->flags & kMmapRingTail) {
+                text += "[truncated] ";
+            }
+        }
+        text.append(slot->text, slot->len);
+        expected = seq + 1;
+        // 写入时就因为比整个环还长被截断
+        if (slot->flags & kMmapRingTruncated) {
+            text += " [truncated]";
+        }
+        if (!(slot->flags & kMmapRingContinued)) {
+            // 记录本身常以换行结尾，避免多出空行
+            while (!text.empty() && text.back() == '\n') {
+                text.pop_back();
+            }
+            std::printf("%s\n", text.c_str());
+            text.clear();
+        }
+    }
+    if (!text.empty()) {
+        std::printf("%s [truncated]\n", text.c_str());
+    }
+    ::munmap(map, st.st_size);
+    return 0;
+}